@@ -176,9 +176,74 @@ def transcribe_with_chunking(asr, audio_path, chunk_duration=120.0, overlap_dura
 
     return tokens_to_sentences(all_tokens, all_timestamps)
 
+def transcribe_array(asr, audio, chunk_duration=120.0, overlap_duration=15.0, sample_rate=16000):
+    """
+    Transcribe an in-memory float32 waveform (e.g. piped over stdin),
+    chunking long audio the same way as transcribe_with_chunking.
+
+    Args:
+        asr: ASR model instance (with timestamps)
+        audio: 1-D np.float32 array at sample_rate
+        chunk_duration: Duration of each chunk in seconds
+        overlap_duration: Overlap between chunks in seconds
+        sample_rate: Sample rate of the waveform
+
+    Returns:
+        List of sentence dicts with {text, start, end}
+    """
+    total_samples = len(audio)
+    duration = total_samples / sample_rate
+
+    if duration <= chunk_duration:
+        result = asr.recognize(audio, sample_rate=sample_rate)
+        if hasattr(result, 'tokens') and hasattr(result, 'timestamps'):
+            return tokens_to_sentences(result.tokens, result.timestamps)
+        text = result.text if hasattr(result, 'text') else str(result)
+        return [{'text': text, 'start': 0.0, 'end': duration}]
+
+    print(f"Processing {duration:.1f}s audio in chunks of {chunk_duration}s...", file=sys.stderr)
+
+    chunk_samples = int(chunk_duration * sample_rate)
+    overlap_samples = int(overlap_duration * sample_rate)
+    stride = chunk_samples - overlap_samples
+    total_chunks = (total_samples - overlap_samples - 1) // stride + 1
+
+    all_tokens = []
+    all_timestamps = []
+
+    for chunk_idx, start in enumerate(range(0, total_samples, stride)):
+        end = min(start + chunk_samples, total_samples)
+        chunk_start = start / sample_rate
+        chunk_end = end / sample_rate
+
+        print(f"Processing chunk {chunk_idx+1}/{total_chunks} ({chunk_start:.1f}s - {chunk_end:.1f}s)...", file=sys.stderr)
+        result = asr.recognize(audio[start:end], sample_rate=sample_rate)
+
+        if hasattr(result, 'tokens') and hasattr(result, 'timestamps'):
+            adjusted_timestamps = [ts + chunk_start for ts in result.timestamps]
+
+            if chunk_idx > 0 and all_timestamps:
+                last_prev_time = all_timestamps[-1]
+                overlap_end = chunk_start + overlap_duration
+
+                for token, ts in zip(result.tokens, adjusted_timestamps):
+                    if ts >= overlap_end or ts > last_prev_time:
+                        all_tokens.append(token)
+                        all_timestamps.append(ts)
+            else:
+                all_tokens.extend(result.tokens)
+                all_timestamps.extend(adjusted_timestamps)
+
+        if end >= total_samples:
+            break
+
+    return tokens_to_sentences(all_tokens, all_timestamps)
+
 def main():
     parser = argparse.ArgumentParser(description='Transcribe audio using Parakeet TDT')
-    parser.add_argument('audio_file', type=str, help='Path to audio file (WAV, 16kHz)')
+    parser.add_argument('audio_file', type=str,
+                       help="Path to audio file (WAV, 16kHz), or '-' to read raw "
+                            "float32 mono 16kHz PCM from stdin")
     parser.add_argument('--model', type=str, default='nemo-parakeet-tdt-0.6b-v2',
                        help='Model name (default: nemo-parakeet-tdt-0.6b-v2)')
     parser.add_argument('--chunk-duration', type=float, default=120.0,
@@ -187,17 +252,44 @@ def main():
                        help='Model quantization (default: int8, options: int8, None)')
     args = parser.parse_args()
 
-    audio_file = Path(args.audio_file)
-    if not audio_file.exists():
-        print(f"ERROR: Audio file not found: {audio_file}", file=sys.stderr)
-        sys.exit(1)
+    use_stdin = args.audio_file == '-'
+
+    if not use_stdin:
+        audio_file = Path(args.audio_file)
+        if not audio_file.exists():
+            print(f"ERROR: Audio file not found: {audio_file}", file=sys.stderr)
+            sys.exit(1)
 
     try:
         start_time = time.time()
 
         quantization = None if args.quantization.lower() == 'none' else args.quantization
-        asr = load_model(args.model, quantization=quantization, providers=['CPUExecutionProvider']).with_timestamps()
-        sentences = transcribe_with_chunking(asr, str(audio_file), chunk_duration=args.chunk_duration)
+
+        # ONNX Runtime defaults leave graph optimizations conservative; for a
+        # TDT model with many small ops, full optimization plus one intra-op
+        # thread per physical core measurably cuts per-chunk latency.
+        import onnxruntime as ort
+        sess_options = ort.SessionOptions()
+        sess_options.graph_optimization_level = ort.GraphOptimizationLevel.ORT_ENABLE_ALL
+        sess_options.execution_mode = ort.ExecutionMode.ORT_SEQUENTIAL
+        sess_options.intra_op_num_threads = max(1, (os.cpu_count() or 2) // 2)
+
+        try:
+            asr = load_model(args.model, quantization=quantization,
+                             sess_options=sess_options,
+                             providers=['CPUExecutionProvider']).with_timestamps()
+        except TypeError:
+            # Older onnx-asr without a sess_options parameter
+            asr = load_model(args.model, quantization=quantization,
+                             providers=['CPUExecutionProvider']).with_timestamps()
+
+        if use_stdin:
+            # Raw headerless PCM over the pipe skips the WAV encode/decode
+            # round-trip entirely.
+            audio = np.frombuffer(sys.stdin.buffer.read(), dtype=np.float32)
+            sentences = transcribe_array(asr, audio, chunk_duration=args.chunk_duration)
+        else:
+            sentences = transcribe_with_chunking(asr, str(audio_file), chunk_duration=args.chunk_duration)
 
         for segment in sentences:
             print(json.dumps(segment))
@@ -1,37 +1,66 @@
 #pragma once
 
+#include <array>
 #include <string>
-#include <vector>
+#include <string_view>
 
 #include <juce_core/juce_core.h>
 
 struct Config
 {
-    static inline const std::vector<std::pair<std::string, std::string>> models = {
-        { "onnx-nemo-parakeet-tdt-0.6b-v2", "Parakeet" },
-        // { "onnx-onnx-community/whisper-large-v3-turbo", "ONNX W Turbo" },
-        { "small", "Whisper Small" },
-        { "medium", "Whisper Medium" },
-        { "large-v3", "Whisper Large" },
-        { "large-v3-turbo", "Whisper Turbo" }
+    enum class ModelKind
+    {
+        whisper,
+        onnx
     };
 
-    static const juce::URL getModelURL (std::string modelNameIn)
+    struct Model
     {
-        if (isOnnxModel (modelNameIn))
-            return juce::URL ("");
+        std::string_view name;
+        std::string_view label;
+        ModelKind kind;
+    };
+
+    static constexpr std::array<Model, 5> models = {{
+        { "onnx-nemo-parakeet-tdt-0.6b-v2", "Parakeet", ModelKind::onnx },
+        // { "onnx-onnx-community/whisper-large-v3-turbo", "ONNX W Turbo", ModelKind::onnx },
+        { "small", "Whisper Small", ModelKind::whisper },
+        { "medium", "Whisper Medium", ModelKind::whisper },
+        { "large-v3", "Whisper Large", ModelKind::whisper },
+        { "large-v3-turbo", "Whisper Turbo", ModelKind::whisper }
+    }};
+
+    // Look up a model's kind by exact name. Unknown names are treated as
+    // Whisper models, since those are the only ones downloaded by name.
+    static constexpr ModelKind getModelKind (std::string_view modelName)
+    {
+        for (const auto& model : models)
+            if (model.name == modelName)
+                return model.kind;
+        return ModelKind::whisper;
+    }
 
-        return juce::URL ("https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-" + modelNameIn + ".bin");
+    static constexpr bool isOnnxModel (std::string_view modelName)
+    {
+        return getModelKind (modelName) == ModelKind::onnx;
     }
 
-    static const std::string getModelsDir()
+    static const juce::URL getModelURL (std::string_view modelName)
     {
-        const auto tempDir = juce::File::getSpecialLocation (juce::File::SpecialLocationType::tempDirectory);
-        return tempDir.getFullPathName().toStdString() + "/models/";
+        if (isOnnxModel (modelName))
+            return juce::URL ("");
+
+        return juce::URL ("https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-"
+            + juce::String (modelName.data(), modelName.size()) + ".bin");
     }
 
-    static bool isOnnxModel (const std::string& modelName)
+    static const std::string& getModelsDir()
     {
-        return modelName.find ("onnx-") == 0;
+        static const std::string modelsDir = []
+        {
+            const auto tempDir = juce::File::getSpecialLocation (juce::File::SpecialLocationType::tempDirectory);
+            return tempDir.getFullPathName().toStdString() + "/models/";
+        }();
+        return modelsDir;
     }
 };
@@ -18,7 +18,7 @@ public:
         return transcript;
     }
 
-    void setTranscript (const juce::var& newTranscript) noexcept
+    void setTranscript (juce::var newTranscript) noexcept
     {
         if (! newTranscript.isObject())
         {
@@ -28,7 +28,7 @@ public:
 
         if (transcript != newTranscript)
         {
-            transcript = newTranscript;
+            transcript = std::move (newTranscript);
             notifyContentChanged (juce::ARAContentUpdateScopes::nothingIsAffected(), false);
         }
     }
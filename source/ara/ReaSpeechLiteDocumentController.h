@@ -1,5 +1,10 @@
 #pragma once
 
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
 
@@ -29,15 +34,38 @@ public:
         return getDocumentController()->getHostPlaybackController();
     }
 
+    // Constant-time audio source lookup by persistent ID. The index is
+    // rebuilt lazily after each editing cycle - every model change (adding,
+    // removing or re-identifying audio sources) happens between
+    // willBeginEditing and didEndEditing, so a flag set there is enough to
+    // keep the map coherent.
+    ReaSpeechLiteAudioSource* getAudioSourceByPersistentID (const juce::String& persistentID)
+    {
+        if (audioSourceIndexDirty)
+        {
+            audioSourceIndex.clear();
+
+            if (auto* document = getDocument())
+                for (const auto& audioSource : document->getAudioSources<ReaSpeechLiteAudioSource>())
+                    audioSourceIndex.emplace (audioSource->getPersistentID(), audioSource);
+
+            audioSourceIndexDirty = false;
+        }
+
+        const auto it = audioSourceIndex.find (persistentID.toStdString());
+        return it != audioSourceIndex.end() ? it->second : nullptr;
+    }
+
 protected:
     void willBeginEditing (juce::ARADocument*) noexcept override
     {
-        processBlockLock.enterWrite();
+        processBlockLock.lock();
     }
 
     void didEndEditing (juce::ARADocument*) noexcept override
     {
-        processBlockLock.exitWrite();
+        audioSourceIndexDirty = true;
+        processBlockLock.unlock();
     }
 
     juce::ARAAudioSource* doCreateAudioSource (juce::ARADocument* document, ARA::ARAAudioSourceHostRef hostRef) noexcept override
@@ -52,32 +80,66 @@ protected:
 
     bool doRestoreObjectsFromStream (juce::ARAInputStream& input, const juce::ARARestoreObjectsFilter* filter) noexcept override
     {
+        const auto firstField = input.readInt64();
+
+        // Legacy archives start with a non-negative audio source count and
+        // store one JSON transcript per source.
+        if (firstField >= 0)
+        {
+            for (juce::int64 i = 0; i < firstField; ++i)
+            {
+                auto audioSourceID = input.readString();
+                auto transcriptJSON = input.readString();
+                auto filePath = input.readString();
+
+                if (! restoreAudioSource (audioSourceID, transcriptJSON, filePath, filter))
+                    return false;
+            }
+
+            return ! input.failed();
+        }
+
+        // Deduplicated archives (marked by a leading -1) store a table of
+        // unique transcript blobs first, then per-source references into it.
+        const auto numBlobs = input.readInt64();
+
+        // The counts come straight off the archive, so a corrupt or
+        // truncated stream must not drive the allocations or read loops:
+        // reject anything negative or implausibly large (reserve throwing
+        // inside this noexcept override would terminate the host), and stop
+        // reading as soon as the stream reports failure.
+        constexpr juce::int64 maxArchiveEntries = 1 << 20;
+
+        if (input.failed() || numBlobs < 0 || numBlobs > maxArchiveEntries)
+            return false;
+
+        std::vector<juce::String> blobs;
+        blobs.reserve (static_cast<size_t> (numBlobs));
+
+        for (juce::int64 i = 0; i < numBlobs; ++i)
+        {
+            blobs.push_back (input.readString());
+
+            if (input.failed())
+                return false;
+        }
+
         const auto numAudioSources = input.readInt64();
 
+        if (input.failed() || numAudioSources < 0 || numAudioSources > maxArchiveEntries)
+            return false;
+
         for (juce::int64 i = 0; i < numAudioSources; ++i)
         {
             auto audioSourceID = input.readString();
-            auto transcriptJSON = input.readString();
+            const auto blobIndex = input.readInt64();
             auto filePath = input.readString();
 
-            auto audioSource = filter->getAudioSourceToRestoreStateWithID<ReaSpeechLiteAudioSource> (audioSourceID.getCharPointer());
-
-            if (audioSource == nullptr)
-                continue;
-
-            juce::var transcript;
-            auto result = juce::JSON::parse (transcriptJSON, transcript);
+            if (blobIndex < 0 || blobIndex >= (juce::int64) blobs.size())
+                return false;
 
-            if (result.wasOk())
-            {
-                audioSource->setTranscript (transcript);
-                audioSource->setFilePath (filePath);
-            }
-            else
-            {
-                DBG ("Failed to parse transcript JSON for audio source ID: " + audioSourceID);
+            if (! restoreAudioSource (audioSourceID, blobs[(size_t) blobIndex], filePath, filter))
                 return false;
-            }
         }
 
         return ! input.failed();
@@ -88,6 +150,38 @@ protected:
         const auto& audioSourcesToPersist { filter->getAudioSourcesToStore<ReaSpeechLiteAudioSource>() };
         const auto numAudioSources = audioSourcesToPersist.size();
 
+        // Serialize each transcript once and deduplicate identical blobs, so
+        // the same file used by several audio sources is stored a single time.
+        std::vector<const std::string*> blobs;
+        std::unordered_map<std::string, juce::int64> blobIndexByContent;
+        std::vector<juce::int64> blobIndexForSource (numAudioSources);
+
+        for (size_t i = 0; i < numAudioSources; ++i)
+        {
+            juce::MemoryOutputStream json;
+            juce::JSON::writeToStream (json, audioSourcesToPersist[i]->getTranscript());
+
+            std::string bytes (static_cast<const char*> (json.getData()), json.getDataSize());
+
+            const auto [it, inserted] = blobIndexByContent.emplace (std::move (bytes), (juce::int64) blobs.size());
+            if (inserted)
+                blobs.push_back (&it->first);
+
+            blobIndexForSource[i] = it->second;
+        }
+
+        // The leading -1 distinguishes the deduplicated format from legacy
+        // archives, whose first field was a non-negative source count.
+        if (! output.writeInt64 (-1))
+            return false;
+
+        if (! output.writeInt64 ((juce::int64) blobs.size()))
+            return false;
+
+        for (const auto* blob : blobs)
+            if (! output.write (blob->data(), blob->size()) || ! output.writeByte (0))
+                return false;
+
         if (! output.writeInt64 ((juce::int64) numAudioSources))
             return false;
 
@@ -96,8 +190,7 @@ protected:
             if (! output.writeString (audioSourcesToPersist[i]->getPersistentID()))
                 return false;
 
-            juce::String transcriptJSON = juce::JSON::toString (audioSourcesToPersist[i]->getTranscript());
-            if (! output.writeString (transcriptJSON))
+            if (! output.writeInt64 (blobIndexForSource[i]))
                 return false;
 
             if (! output.writeString (audioSourcesToPersist[i]->getFilePath()))
@@ -108,12 +201,39 @@ protected:
     }
 
 private:
-    juce::ScopedTryReadLock getProcessingLock() override
+    bool restoreAudioSource (const juce::String& audioSourceID,
+                             const juce::String& transcriptJSON,
+                             const juce::String& filePath,
+                             const juce::ARARestoreObjectsFilter* filter) noexcept
     {
-        return juce::ScopedTryReadLock { processBlockLock };
+        auto audioSource = filter->getAudioSourceToRestoreStateWithID<ReaSpeechLiteAudioSource> (audioSourceID.getCharPointer());
+
+        if (audioSource == nullptr)
+            return true;
+
+        juce::var transcript;
+        auto result = juce::JSON::parse (transcriptJSON, transcript);
+
+        if (! result.wasOk())
+        {
+            DBG ("Failed to parse transcript JSON for audio source ID: " + audioSourceID);
+            return false;
+        }
+
+        audioSource->setTranscript (std::move (transcript));
+        audioSource->setFilePath (filePath);
+        return true;
     }
 
-    juce::ReadWriteLock processBlockLock;
+    TryReadGuard getProcessingLock() override
+    {
+        return TryReadGuard { processBlockLock };
+    }
+
+    std::shared_mutex processBlockLock;
+
+    std::unordered_map<std::string, ReaSpeechLiteAudioSource*> audioSourceIndex;
+    bool audioSourceIndexDirty = true;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReaSpeechLiteDocumentController)
 };
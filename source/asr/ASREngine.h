@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <juce_core/juce_core.h>
@@ -9,6 +10,7 @@
 
 #include "../utils/SafeUTF8.h"
 #include "ASROptions.h"
+#include "ASRResultCache.h"
 #include "ASRSegment.h"
 
 class ASREngine
@@ -19,44 +21,64 @@ public:
     ~ASREngine()
     {
         DBG ("ASREngine destructor");
-        if (ctx != nullptr)
-        {
-            DBG ("Freeing whisper context");
-            whisper_free (ctx);
-            ctx = nullptr;
-        }
-
+        ctx.reset();
         downloadTask.reset();
     }
 
+    ASREngine (const ASREngine&) = delete;
+    ASREngine& operator= (const ASREngine&) = delete;
+
     // Download the model if needed. Returns true if successful or already downloaded.
-    bool downloadModel (const std::string& modelName, std::function<bool ()> isAborted)
+    // The abort callback is a template parameter so callers can pass a plain
+    // lambda without paying for std::function type erasure.
+    template <typename IsAborted>
+    bool downloadModel (const std::string& modelName, IsAborted&& isAborted)
     {
         std::string modelPath = getModelPath (modelName);
+        const juce::File modelFile (modelPath);
+        const juce::File metaFile (modelPath + ".meta");
 
-        if (juce::File (modelPath).exists())
+        if (modelFile.exists())
         {
-            DBG ("Model already downloaded: " + modelPath);
-            progress.store (100);
-            return true;
+            // A sidecar file records the size of the last completed download.
+            // If it disagrees with what is on disk, the file is a leftover
+            // partial and gets re-fetched. Files without a sidecar predate
+            // this check and are trusted as before.
+            const auto expectedSize = metaFile.existsAsFile()
+                ? metaFile.loadFileAsString().getLargeIntValue()
+                : (juce::int64) 0;
+
+            if (expectedSize == 0 || modelFile.getSize() == expectedSize)
+            {
+                DBG ("Model already downloaded: " + modelPath);
+                progress.store (100, std::memory_order_relaxed);
+                return true;
+            }
+
+            DBG ("Model file size mismatch, re-downloading: " + modelPath);
+            modelFile.deleteFile();
+            metaFile.deleteFile();
         }
 
         juce::File (modelsDir).createDirectory();
-        progress.store (0);
+        progress.store (0, std::memory_order_relaxed);
 
         DBG ("Downloading model");
         juce::URL url = Config::getModelURL (modelName);
         auto file = juce::File (modelPath);
 
-        downloadTask = url.downloadToFile (file, juce::URL::DownloadTaskOptions());
+        juce::WaitableEvent finishedEvent;
+        DownloadListener listener { progress, finishedEvent };
 
-        while (downloadTask != nullptr && !downloadTask->isFinished())
+        downloadTask = url.downloadToFile (file, juce::URL::DownloadTaskOptions().withListener (&listener));
+
+        while (downloadTask != nullptr && ! finishedEvent.wait (250))
         {
             if (isAborted())
             {
                 DBG ("Download aborted");
                 downloadTask.reset();
-                progress.store (0);
+                progress.store (0, std::memory_order_relaxed);
 
                 if (juce::File (modelPath).deleteFile())
                 {
@@ -65,22 +87,13 @@ public:
 
                 return false;
             }
-
-            auto totalLength = downloadTask->getTotalLength();
-            if (totalLength > 0)
-            {
-                auto downloadedLength = downloadTask->getLengthDownloaded();
-                progress.store (static_cast<int> ((downloadedLength * 100) / totalLength));
-            }
-
-            juce::Thread::sleep (100);
         }
 
         if (downloadTask == nullptr || downloadTask->hadError())
         {
             DBG ("Failed to download model");
             downloadTask.reset();
-            progress.store (0);
+            progress.store (0, std::memory_order_relaxed);
 
             if (juce::File (modelPath).deleteFile())
             {
@@ -91,7 +104,8 @@ public:
         }
 
         downloadTask.reset();
-        progress.store (100);
+        metaFile.replaceWithText (juce::String (modelFile.getSize()));
+        progress.store (100, std::memory_order_relaxed);
         return true;
     }
 
@@ -109,7 +123,7 @@ public:
         if (ctx != nullptr)
         {
             DBG ("Freeing whisper context");
-            whisper_free (ctx);
+            ctx.reset();
         }
 
         std::string modelPath = getModelPath (modelName);
@@ -123,7 +137,7 @@ public:
 
         whisper_context_params params = whisper_context_default_params();
 
-        ctx = whisper_init_from_file_with_params (modelPath.c_str(), params);
+        ctx.reset (whisper_init_from_file_with_params (modelPath.c_str(), params));
         if (ctx == nullptr)
         {
             DBG ("Failed to load model");
@@ -137,16 +151,24 @@ public:
         }
 
         DBG ("Model loaded successfully");
+
+        // Most whisper parameters are constant for this plugin, so build the
+        // params struct once per model load and just patch the per-request
+        // fields in transcribe.
+        baseParams = whisper_full_default_params (WHISPER_SAMPLING_GREEDY);
+        baseParams.token_timestamps = true;
+
         lastModelName = modelName;
         return true;
     }
 
     // Transcribe the audio data. Returns true if successful.
+    template <typename IsAborted>
     bool transcribe (
         const std::vector<float>& audioData,
         ASROptions& options,
         std::vector<ASRSegment>& segments,
-        std::function<bool ()> isAborted)
+        IsAborted&& isAborted)
     {
         DBG ("ASREngine::transcribe");
         if (ctx == nullptr)
@@ -157,110 +179,245 @@ public:
 
         auto startTime = juce::Time::getMillisecondCounterHiRes();
 
-        TranscribeCallbackData callbackData { this, isAborted };
+        // Re-transcribing the same audio with the same options is common
+        // while tuning; the cache turns that into a hash pass plus a copy.
+        const auto cacheKey = ASRResultCache::makeKey (audioData, options.toJSON().toStdString());
+
+        if (resultCache.lookup (cacheKey, segments))
+        {
+            DBG ("Returning cached transcription");
+            auto endTime = juce::Time::getMillisecondCounterHiRes();
+            processingTimeSeconds.store ((endTime - startTime) / 1000.0, std::memory_order_relaxed);
+            progress.store (100, std::memory_order_relaxed);
+            return true;
+        }
+
+        struct CallbackData
+        {
+            ASREngine* engine;
+            IsAborted& isAborted;
+        };
+
+        CallbackData callbackData { this, isAborted };
 
-        whisper_full_params params = whisper_full_default_params (WHISPER_SAMPLING_GREEDY);
-        params.token_timestamps = true;
-        params.language = options.language.toStdString().c_str();
+        // Keep the language string alive for the duration of the call;
+        // whisper holds the pointer rather than copying it.
+        languageHolder = options.language.toStdString();
+
+        whisper_full_params params = baseParams;
+        params.language = languageHolder.c_str();
         params.translate = options.translate;
 
         params.encoder_begin_callback = [] (whisper_context*, whisper_state*, void* user_data)
         {
-            auto* data = static_cast<TranscribeCallbackData*> (user_data);
+            auto* data = static_cast<CallbackData*> (user_data);
             return ! data->isAborted();
         };
         params.encoder_begin_callback_user_data = &callbackData;
 
         params.progress_callback = [] (whisper_context*, whisper_state*, int progressIn, void* user_data)
         {
-            auto* data = static_cast<TranscribeCallbackData*> (user_data);
-            data->engine->progress.store (progressIn);
+            // Workers report progress independently in parallel mode, so
+            // only ever move the published value forward.
+            auto& progressOut = static_cast<CallbackData*> (user_data)->engine->progress;
+            int previous = progressOut.load (std::memory_order_relaxed);
+            while (progressIn > previous
+                   && ! progressOut.compare_exchange_weak (previous, progressIn, std::memory_order_relaxed))
+            {}
         };
         params.progress_callback_user_data = &callbackData;
-        progress.store (0);
+        progress.store (0, std::memory_order_relaxed);
+
+        // Chunk long audio across processors; short clips stay on the single
+        // context path where the split overhead would dominate.
+        const int numProcessors = juce::jlimit (1, 4, (int) std::thread::hardware_concurrency() / 2);
+        const bool useParallel = numProcessors > 1
+            && audioData.size() > (size_t) WHISPER_SAMPLE_RATE * 60;
+
+        const int fullResult = useParallel
+            ? whisper_full_parallel (ctx.get(), params, audioData.data(), static_cast<int> (audioData.size()), numProcessors)
+            : whisper_full (ctx.get(), params, audioData.data(), static_cast<int> (audioData.size()));
 
-        if (whisper_full (ctx, params, audioData.data(), static_cast<int> (audioData.size())) != 0)
+        if (fullResult != 0)
         {
             DBG ("Transcription failed");
             return false;
         }
 
-        int nSegments = whisper_full_n_segments (ctx);
+        int nSegments = whisper_full_n_segments (ctx.get());
         DBG ("Number of segments: " + juce::String (nSegments));
 
-        for (int i = 0; i < nSegments; ++i)
+        const int eot = whisper_token_eot (ctx.get());
+
+        const auto firstNewSegment = segments.size();
+        segments.resize (firstNewSegment + static_cast<size_t> (nSegments));
+
+        // Whisper's segment/token accessors are read-only once whisper_full
+        // has returned, so each segment can be post-processed independently.
+        auto buildSegment = [this, eot, firstNewSegment, &segments] (int i)
         {
-            ASRSegment segment;
+            ASRSegment& segment = segments[firstNewSegment + static_cast<size_t> (i)];
+
+            auto sanitized = SafeUTF8::sanitize (whisper_full_get_segment_text (ctx.get(), i));
+            const auto firstChar = sanitized.find_first_not_of (" \t\n\r");
+            const auto lastChar = sanitized.find_last_not_of (" \t\n\r");
+            segment.text = firstChar == std::string::npos ? std::string()
+                                                          : sanitized.substr (firstChar, lastChar - firstChar + 1);
+            segment.start = ((float) whisper_full_get_segment_t0 (ctx.get(), i)) / 100.0f;
+            segment.end = ((float) whisper_full_get_segment_t1 (ctx.get(), i)) / 100.0f;
+
+            int nTokens = whisper_full_n_tokens (ctx.get(), i);
+            segment.words.ensureStorageAllocated (nTokens);
+
+            // Gather the per-token structs into one contiguous block first so
+            // the merge loop below streams over a hot, linear array instead of
+            // chasing into whisper's internals for every field. The buffer is
+            // thread_local because buildSegment may run on several workers.
+            thread_local std::vector<whisper_token_data> tokenDataBlock;
+            tokenDataBlock.resize (static_cast<size_t> (nTokens));
 
-            segment.text = SafeUTF8::encode (whisper_full_get_segment_text (ctx, i)).trim();
-            segment.start = ((float) whisper_full_get_segment_t0 (ctx, i)) / 100.0f;
-            segment.end = ((float) whisper_full_get_segment_t1 (ctx, i)) / 100.0f;
+            for (int j = 0; j < nTokens; ++j)
+                tokenDataBlock[static_cast<size_t> (j)] = whisper_full_get_token_data (ctx.get(), i, j);
 
-            int nTokens = whisper_full_n_tokens (ctx, i);
             for (int j = 0; j < nTokens; ++j)
             {
-                if (whisper_full_get_token_id (ctx, i, j) >= whisper_token_eot (ctx))
-                    continue;
+                const auto& tokenData = tokenDataBlock[static_cast<size_t> (j)];
 
-                ASRWord word;
+                if (tokenData.id >= eot)
+                    continue;
 
-                word.text = SafeUTF8::encode (whisper_full_get_token_text (ctx, i, j));
-                word.start = ((float) whisper_full_get_token_data (ctx, i, j).t0) / 100.0f;
-                word.end = ((float) whisper_full_get_token_data (ctx, i, j).t1) / 100.0f;
-                word.probability = whisper_full_get_token_p (ctx, i, j);
+                const char* tokenText = whisper_full_get_token_text (ctx.get(), i, j);
+                const float tokenEnd = ((float) tokenData.t1) / 100.0f;
 
-                if (! segment.words.isEmpty() && ! word.text.isEmpty() && word.text[0] != ' ')
+                // A token that continues the previous word starts without a
+                // leading space; check the raw bytes so continuation tokens
+                // are appended without building an intermediate ASRWord.
+                if (! segment.words.isEmpty() && tokenText != nullptr
+                    && tokenText[0] != '\0' && tokenText[0] != ' ')
                 {
                     auto& lastWord = segment.words.getReference (segment.words.size() - 1);
-                    lastWord.end = word.end;
-                    lastWord.text += word.text.trim();
+                    lastWord.end = tokenEnd;
+                    lastWord.text += SafeUTF8::encode (tokenText).trim();
                 }
                 else
                 {
-                    word.text = word.text.trim();
-                    segment.words.add (word);
+                    ASRWord word;
+
+                    word.text = SafeUTF8::encode (tokenText).trim();
+                    word.start = ((float) tokenData.t0) / 100.0f;
+                    word.end = tokenEnd;
+                    word.probability = tokenData.p;
+
+                    segment.words.add (std::move (word));
                 }
             }
+        };
+
+        // Only fan out when there is enough work to amortize thread startup.
+        const int numThreads = nSegments >= 16
+            ? juce::jlimit (1, 4, (int) std::thread::hardware_concurrency())
+            : 1;
+
+        if (numThreads > 1)
+        {
+            std::vector<std::thread> workers;
+            workers.reserve (static_cast<size_t> (numThreads));
 
-            segments.push_back (segment);
+            for (int t = 0; t < numThreads; ++t)
+                workers.emplace_back ([&buildSegment, t, numThreads, nSegments]
+                {
+                    for (int i = t; i < nSegments; i += numThreads)
+                        buildSegment (i);
+                });
+
+            for (auto& worker : workers)
+                worker.join();
+        }
+        else
+        {
+            for (int i = 0; i < nSegments; ++i)
+                buildSegment (i);
         }
 
+        // An abort makes whisper stop early but still return success, so the
+        // segment list may be truncated; caching it would replay the partial
+        // transcript as a complete result next time this clip is run.
+        if (! isAborted())
+            resultCache.store (cacheKey,
+                std::vector<ASRSegment> (segments.begin() + (std::ptrdiff_t) firstNewSegment, segments.end()));
+
         auto endTime = juce::Time::getMillisecondCounterHiRes();
-        processingTimeSeconds.store ((endTime - startTime) / 1000.0);
+        processingTimeSeconds.store ((endTime - startTime) / 1000.0, std::memory_order_relaxed);
 
-        progress.store (100);
+        progress.store (100, std::memory_order_relaxed);
         return true;
     }
 
     // Get the full path to a model file based on its name
     std::string getModelPath (const std::string& modelName) const
     {
-        return modelsDir + "ggml-" + modelName + ".bin";
+        std::string path;
+        path.reserve (modelsDir.size() + 5 + modelName.size() + 4); // "ggml-" + name + ".bin"
+        path += modelsDir;
+        path += "ggml-";
+        path += modelName;
+        path += ".bin";
+        return path;
     }
 
     // Get current progress (0-100) of download or transcription
     int getProgress() const
     {
-        return progress.load();
+        return progress.load (std::memory_order_relaxed);
     }
 
     // Get processing time in seconds from last transcription
     double getProcessingTime() const
     {
-        return processingTimeSeconds.load();
+        return processingTimeSeconds.load (std::memory_order_relaxed);
     }
 
 private:
-    struct TranscribeCallbackData
+    // Updates download progress and signals completion, so downloadModel can
+    // block on an event instead of polling the task every 100 ms.
+    struct DownloadListener final : public juce::URL::DownloadTask::Listener
+    {
+        DownloadListener (std::atomic<int>& progressIn, juce::WaitableEvent& finishedEventIn)
+            : progressValue (progressIn), finishedEvent (finishedEventIn) {}
+
+        void progress (juce::URL::DownloadTask*, juce::int64 bytesDownloaded, juce::int64 totalLength) override
+        {
+            if (totalLength > 0)
+                progressValue.store (static_cast<int> ((bytesDownloaded * 100) / totalLength), std::memory_order_relaxed);
+        }
+
+        void finished (juce::URL::DownloadTask*, bool) override
+        {
+            finishedEvent.signal();
+        }
+
+        std::atomic<int>& progressValue;
+        juce::WaitableEvent& finishedEvent;
+    };
+
+    // Frees the whisper context when the engine is destroyed or a new
+    // model is loaded; prevents accidental copies from double-freeing.
+    struct WhisperContextDeleter
     {
-        ASREngine* engine;
-        std::function<bool()> isAborted;
+        void operator() (whisper_context* c) const noexcept { whisper_free (c); }
     };
 
     std::string modelsDir;
     std::string lastModelName;
-    whisper_context* ctx = nullptr;
+    std::string languageHolder;
+    std::unique_ptr<whisper_context, WhisperContextDeleter> ctx;
+    whisper_full_params baseParams {};
     std::unique_ptr<juce::URL::DownloadTask> downloadTask;
-    std::atomic<int> progress;
-    std::atomic<double> processingTimeSeconds{0.0};
+    ASRResultCache resultCache;
+
+    // Polled from the UI while worker threads write; relaxed ordering is
+    // enough (plain progress values), and cache-line alignment keeps the
+    // pollers from bouncing neighbouring members between cores.
+    alignas (64) std::atomic<int> progress { 0 };
+    alignas (64) std::atomic<double> processingTimeSeconds { 0.0 };
 };
@@ -8,12 +8,17 @@ struct ASROptions
     juce::String language;
     bool translate;
 
+    // ONNX model quantization ("int8" or "none"); only meaningful for the
+    // Parakeet engine, where int8 roughly halves inference time on CPU.
+    juce::String quantization { "int8" };
+
     juce::String toJSON() const
     {
         juce::DynamicObject::Ptr obj = new juce::DynamicObject();
         obj->setProperty ("modelName", modelName);
         obj->setProperty ("language", language);
         obj->setProperty ("translate", translate);
+        obj->setProperty ("quantization", quantization);
         return juce::JSON::toString (juce::var (obj.get()));
     }
 };
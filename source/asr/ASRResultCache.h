@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ASRSegment.h"
+
+// Small LRU cache of finished transcriptions, keyed by audio content plus the
+// options that produced them. Users often re-transcribe the same clip while
+// tuning markers or options; a hash pass over the samples is a single linear
+// sweep, orders of magnitude cheaper than redoing inference.
+class ASRResultCache
+{
+public:
+    // FNV-1a over 64-bit chunks of the raw sample bytes, mixed with a stable
+    // rendering of the options (model name, language, quantization, ...).
+    static std::uint64_t makeKey (const std::vector<float>& audioData, const std::string& optionsKey)
+    {
+        std::uint64_t hash = 1469598103934665603ULL;
+
+        auto mix = [&hash] (std::uint64_t value)
+        {
+            hash ^= value;
+            hash *= 1099511628211ULL;
+        };
+
+        const auto* bytes = reinterpret_cast<const std::uint8_t*> (audioData.data());
+        const auto numBytes = audioData.size() * sizeof (float);
+
+        size_t i = 0;
+        for (; i + 8 <= numBytes; i += 8)
+        {
+            std::uint64_t chunk;
+            std::memcpy (&chunk, bytes + i, 8);
+            mix (chunk);
+        }
+
+        if (i < numBytes)
+        {
+            std::uint64_t tail = 0;
+            std::memcpy (&tail, bytes + i, numBytes - i);
+            mix (tail);
+        }
+
+        mix (numBytes);
+
+        for (const char ch : optionsKey)
+            mix ((std::uint64_t) (std::uint8_t) ch);
+
+        return hash;
+    }
+
+    // Appends the cached segments to the output and returns true on a hit,
+    // marking the entry most recently used.
+    bool lookup (std::uint64_t key, std::vector<ASRSegment>& segments)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        const auto it = index.find (key);
+        if (it == index.end())
+            return false;
+
+        entries.splice (entries.begin(), entries, it->second);
+        const auto& cached = entries.front().segments;
+        segments.insert (segments.end(), cached.begin(), cached.end());
+        return true;
+    }
+
+    void store (std::uint64_t key, const std::vector<ASRSegment>& segments)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (index.find (key) != index.end())
+            return;
+
+        entries.push_front ({ key, segments });
+        index[key] = entries.begin();
+
+        if (entries.size() > maxEntries)
+        {
+            index.erase (entries.back().key);
+            entries.pop_back();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t key;
+        std::vector<ASRSegment> segments;
+    };
+
+    // Segment text is tiny next to the audio it came from, so a handful of
+    // entries covers the re-transcribe-while-tuning case without meaningful
+    // memory cost.
+    static constexpr size_t maxEntries = 8;
+
+    std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <juce_core/juce_core.h>
 
 struct ASRWord
@@ -24,7 +26,9 @@ struct ASRWord
 
 struct ASRSegment
 {
-    juce::String text;
+    // Kept as raw UTF-8: both engines produce UTF-8 bytes, and converting to
+    // juce::String is deferred to the JSON boundary below.
+    std::string text;
     float start;
     float end;
     juce::Array<ASRWord> words;
@@ -33,7 +37,7 @@ struct ASRSegment
     {
         juce::DynamicObject::Ptr obj = new juce::DynamicObject();
 
-        obj->setProperty ("text", this->text);
+        obj->setProperty ("text", juce::String::fromUTF8 (this->text.data(), (int) this->text.size()));
         obj->setProperty ("start", this->start);
         obj->setProperty ("end", this->end);
         obj->setProperty ("score", this->score());
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <juce_core/juce_core.h>
@@ -10,6 +16,7 @@
 #include "../utils/SafeUTF8.h"
 #include "../reaper/ReaperProxy.h"
 #include "ASROptions.h"
+#include "ASRResultCache.h"
 #include "ASRSegment.h"
 
 class OnnxPythonEngine
@@ -20,12 +27,13 @@ public:
 
     ~OnnxPythonEngine() = default;
 
-    bool downloadModel (const std::string& /*modelName*/, std::function<bool ()> /*isAborted*/)
+    template <typename IsAborted>
+    bool downloadModel (const std::string& /*modelName*/, IsAborted&& /*isAborted*/)
     {
         if (! checkPythonAvailable())
             return false;
 
-        progress.store (100);
+        progress.store (100, std::memory_order_relaxed);
         return true;
     }
 
@@ -38,96 +46,139 @@ public:
         return true;
     }
 
+    template <typename IsAborted>
     bool transcribe (
         const std::vector<float>& audioData,
-        ASROptions& /*options*/,
+        ASROptions& options,
         std::vector<ASRSegment>& segments,
-        std::function<bool ()> isAborted)
+        IsAborted&& isAborted)
     {
+        if (isAborted())
+            return false;
+
         auto startTime = juce::Time::getMillisecondCounterHiRes();
-        progress.store (0);
+        progress.store (0, std::memory_order_relaxed);
 
         auto updateProcessingTime = [&]() {
             auto endTime = juce::Time::getMillisecondCounterHiRes();
-            processingTimeSeconds.store ((endTime - startTime) / 1000.0);
+            processingTimeSeconds.store ((endTime - startTime) / 1000.0, std::memory_order_relaxed);
         };
 
         // Clear any existing segments from previous transcription
         segments.clear();
 
+        // Re-transcribing the same audio with the same options is common
+        // while tuning; the cache turns that into a hash pass plus a copy.
+        const auto cacheKey = ASRResultCache::makeKey (audioData, options.toJSON().toStdString());
+
+        if (resultCache.lookup (cacheKey, segments))
+        {
+            logToConsole ("Parakeet: Returning cached transcription");
+            updateProcessingTime();
+            progress.store (100, std::memory_order_relaxed);
+            return true;
+        }
+
         try
         {
-            float audioDuration = static_cast<float> (audioData.size()) / 16000.0f;
+            const float audioDuration = static_cast<float> (audioData.size()) * (1.0f / 16000.0f);
             logToConsole ("Parakeet: Starting transcription for " +
                          juce::String (audioDuration, 1) + "s audio");
 
-            auto tempFile = juce::File::getSpecialLocation (juce::File::tempDirectory)
-                .getChildFile ("reaspeech_temp_" + juce::String (juce::Random::getSystemRandom().nextInt()) + ".wav");
-
-            if (! writeWavFile (tempFile, audioData, 16000))
+            // TemporaryFile picks a unique name and deletes the audio file
+            // on every exit path, including the failure returns and the
+            // catch below that previously leaked it.
+            const juce::TemporaryFile tempAudio (".flac");
+            const auto& tempFile = tempAudio.getFile();
+
+            // FLAC halves the bytes written to and re-read from disk for
+            // 16-bit speech at negligible encode cost; libsndfile on the
+            // Python side sniffs the container from content, so the WAV
+            // fallback below works under the same file name. Both writers
+            // poll isAborted between blocks, so an abort during a long write
+            // lands within a megabyte instead of after the whole file.
+            const bool wroteAudio = writeFlacFile (tempFile, audioData, 16000, isAborted)
+                || (! isAborted() && writeWavFile (tempFile, audioData, 16000, isAborted));
+
+            if (! wroteAudio)
             {
-                logToConsole ("Parakeet: Failed to write WAV file");
+                if (! isAborted())
+                    logToConsole ("Parakeet: Failed to write audio file");
+
                 updateProcessingTime();
                 return false;
             }
 
-            progress.store (20);
+            progress.store (20, std::memory_order_relaxed);
 
             if (isAborted())
             {
-                tempFile.deleteFile();
                 updateProcessingTime();
                 return false;
             }
 
             logToConsole ("Parakeet: Running transcription process...");
-            auto transcriptionResult = runPythonTranscription (tempFile.getFullPathName(), isAborted);
-            tempFile.deleteFile();
 
-            if (transcriptionResult.isEmpty())
+            // Sentence segments span a few seconds each; an estimate sized
+            // from the duration replaces the exact newline count, which is
+            // unknown now that lines are parsed as they arrive.
+            segments.reserve ((size_t) (audioDuration / 4.0f) + 16);
+
+            const bool processOk = runPythonTranscription (
+                tempFile.getFullPathName(), options.quantization, isAborted,
+                [this, audioDuration, &segments] (std::string_view line)
+                {
+                    if (line.front() != '{')
+                    {
+                        // Not JSON - this is a progress/debug message from stderr
+                        if (canLogToConsole())
+                            logToConsole ("Parakeet: " + juce::String::fromUTF8 (line.data(), (int) line.size()));
+                        return;
+                    }
+
+                    ASRSegment segment;
+
+                    if (! parseSegmentLine (line, segment))
+                    {
+                        // Rare case (escaped text, unexpected layout) - fall back
+                        // to the full JSON parser for this line.
+                        auto json = juce::JSON::parse (juce::String::fromUTF8 (line.data(), (int) line.size()));
+                        auto jsonObj = json.getDynamicObject();
+
+                        if (jsonObj == nullptr)
+                        {
+                            if (canLogToConsole())
+                                logToConsole ("Parakeet: Failed to parse JSON object: "
+                                    + juce::String::fromUTF8 (line.data(), (int) line.size()));
+                            return;
+                        }
+
+                        segment.text = jsonObj->getProperty ("text").toString().toStdString();
+                        segment.start = static_cast<float> (static_cast<double> (jsonObj->getProperty ("start")));
+                        segment.end = static_cast<float> (static_cast<double> (jsonObj->getProperty ("end")));
+                    }
+
+                    if (segment.text.empty())
+                        return;
+
+                    // Segments arrive in time order, so the latest end time
+                    // gives real progress instead of coarse phase jumps.
+                    if (audioDuration > 0.0f)
+                    {
+                        const auto fraction = juce::jlimit (0.0f, 1.0f, segment.end / audioDuration);
+                        progress.store (25 + (int) (fraction * 70.0f), std::memory_order_relaxed);
+                    }
+
+                    segments.push_back (std::move (segment));
+                });
+
+            if (! processOk)
             {
-                logToConsole ("Parakeet: Transcription returned empty result");
+                logToConsole ("Parakeet: Transcription process failed");
                 updateProcessingTime();
                 return false;
             }
 
-            logToConsole ("Parakeet: Received " + juce::String (transcriptionResult.length()) +
-                         " bytes of output");
-            progress.store (90);
-            juce::StringArray lines;
-            lines.addLines (transcriptionResult);
-
-            for (const auto& line : lines)
-            {
-                auto trimmedLine = line.trim();
-                if (trimmedLine.isEmpty())
-                    continue;
-
-                // Try to parse as JSON
-                auto json = juce::JSON::parse (trimmedLine);
-                if (! json.isObject())
-                {
-                    // Not JSON - this is a progress/debug message from stderr
-                    logToConsole ("Parakeet: " + trimmedLine);
-                    continue;
-                }
-
-                auto jsonObj = json.getDynamicObject();
-                if (jsonObj == nullptr)
-                {
-                    logToConsole ("Parakeet: Failed to parse JSON object: " + trimmedLine);
-                    continue;
-                }
-
-                ASRSegment segment;
-                segment.text = jsonObj->getProperty ("text").toString();
-                segment.start = static_cast<float> (static_cast<double> (jsonObj->getProperty ("start")));
-                segment.end = static_cast<float> (static_cast<double> (jsonObj->getProperty ("end")));
-
-                if (! segment.text.isEmpty())
-                    segments.push_back (segment);
-            }
-
             if (segments.empty())
             {
                 logToConsole ("Parakeet: No valid segments parsed - transcription failed");
@@ -136,9 +187,10 @@ public:
             }
 
             logToConsole ("Parakeet: Successfully parsed " + juce::String (segments.size()) + " segments");
+            resultCache.store (cacheKey, segments);
             updateProcessingTime();
             logToConsole ("Parakeet: Processing time: " + juce::String (processingTimeSeconds.load(), 2) + "s");
-            progress.store (100);
+            progress.store (100, std::memory_order_relaxed);
             return true;
         }
         catch (...)
@@ -150,15 +202,92 @@ public:
 
     int getProgress() const
     {
-        return progress.load();
+        return progress.load (std::memory_order_relaxed);
     }
 
     double getProcessingTime() const
     {
-        return processingTimeSeconds.load();
+        return processingTimeSeconds.load (std::memory_order_relaxed);
     }
 
 private:
+    static std::string_view trimmedView (std::string_view text)
+    {
+        while (! text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r'))
+            text.remove_prefix (1);
+        while (! text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+            text.remove_suffix (1);
+        return text;
+    }
+
+    // Fast path for the child process's fixed one-object-per-line schema:
+    // {"text": "...", "start": 1.0, "end": 2.0}. Avoids building a
+    // DynamicObject per segment. Returns false (leaving the caller to run the
+    // full JSON parser) if the text contains escapes or a key is missing.
+    static bool parseSegmentLine (std::string_view line, ASRSegment& segment)
+    {
+        const auto valueStart = [line] (std::string_view key) -> size_t
+        {
+            const auto keyPos = line.find (key);
+            if (keyPos == std::string_view::npos)
+                return std::string_view::npos;
+
+            auto pos = keyPos + key.size();
+            while (pos < line.size() && (line[pos] == ':' || line[pos] == ' '))
+                ++pos;
+            return pos;
+        };
+
+        const auto textPos = valueStart ("\"text\"");
+        const auto startPos = valueStart ("\"start\"");
+        const auto endPos = valueStart ("\"end\"");
+
+        if (textPos == std::string_view::npos || startPos == std::string_view::npos || endPos == std::string_view::npos)
+            return false;
+
+        if (textPos >= line.size() || line[textPos] != '"')
+            return false;
+
+        const auto closingQuote = line.find ('"', textPos + 1);
+        if (closingQuote == std::string_view::npos)
+            return false;
+
+        const auto text = line.substr (textPos + 1, closingQuote - textPos - 1);
+
+        // Any escape sequence means the closing-quote scan above may have
+        // stopped early; let the full parser deal with it.
+        if (text.find ('\\') != std::string_view::npos)
+            return false;
+
+        if (startPos >= line.size() || endPos >= line.size())
+            return false;
+
+        const auto parseNumber = [line] (size_t pos, float& value)
+        {
+#if defined (__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            return std::from_chars (line.data() + pos, line.data() + line.size(), value).ec == std::errc();
+#else
+            // libc++ ships no floating-point from_chars, so parse a bounded
+            // NUL-terminated copy with JUCE's reader - like from_chars it is
+            // locale-independent, which matters because the child always
+            // writes C-locale numbers. The copy stays tiny: the values are
+            // timestamps a few digits long.
+            char digits[32] {};
+            std::memcpy (digits, line.data() + pos, juce::jmin (sizeof (digits) - 1, line.size() - pos));
+
+            auto text = juce::CharPointer_UTF8 (digits);
+            value = static_cast<float> (juce::CharacterFunctions::readDoubleValue (text));
+            return text != juce::CharPointer_UTF8 (digits);
+#endif
+        };
+
+        if (! parseNumber (startPos, segment.start) || ! parseNumber (endPos, segment.end))
+            return false;
+
+        segment.text.assign (text);
+        return true;
+    }
+
     juce::File findOnnxExecutable()
     {
         juce::StringArray executableNames;
@@ -173,6 +302,21 @@ private:
 
         executableNames.add ("parakeet-transcribe");
 
+        for (const auto& searchPath : getSearchPaths())
+        {
+            for (const auto& exeName : executableNames)
+            {
+                auto exeFile = searchPath.getChildFile (exeName);
+                if (exeFile.existsAsFile())
+                    return exeFile;
+            }
+        }
+
+        return {};
+    }
+
+    static juce::Array<juce::File> getSearchPaths()
+    {
         juce::Array<juce::File> searchPaths;
         auto pluginFile = juce::File::getSpecialLocation (juce::File::currentExecutableFile);
 
@@ -184,14 +328,18 @@ private:
         searchPaths.add (juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
                         .getChildFile ("ReaSpeechLite"));
 
-        for (const auto& searchPath : searchPaths)
+        return searchPaths;
+    }
+
+    // The transcriber script shipped alongside the plugin, used with a
+    // system interpreter when no packaged executable is present.
+    static juce::File findPythonScript()
+    {
+        for (const auto& searchPath : getSearchPaths())
         {
-            for (const auto& exeName : executableNames)
-            {
-                auto exeFile = searchPath.getChildFile (exeName);
-                if (exeFile.existsAsFile())
-                    return exeFile;
-            }
+            auto scriptFile = searchPath.getChildFile ("parakeet_transcribe.py");
+            if (scriptFile.existsAsFile())
+                return scriptFile;
         }
 
         return {};
@@ -199,48 +347,206 @@ private:
 
     bool checkPythonAvailable()
     {
-        auto executable = findOnnxExecutable();
-        if (executable.existsAsFile())
+        // The packaged executable and interpreter locations don't move while
+        // the plugin is loaded, so the filesystem scan and the interpreter
+        // version probe run once per process instead of per engine call.
+        static std::once_flag probeFlag;
+        static juce::String cachedExecutablePath;
+        static juce::String cachedPythonCommand;
+        static juce::String cachedScriptPath;
+        static bool available = false;
+
+        std::call_once (probeFlag, [this]
         {
-            onnxExecutablePath = executable.getFullPathName();
-            return true;
+            auto executable = findOnnxExecutable();
+            if (executable.existsAsFile())
+            {
+                cachedExecutablePath = executable.getFullPathName();
+                available = true;
+                return;
+            }
+
+            // Fallback: a system interpreter running the shipped script. Both
+            // are resolved here, once, so the per-call path never touches the
+            // filesystem or spawns a probe process again.
+            auto script = findPythonScript();
+            if (! script.existsAsFile())
+                return;
+
+            juce::StringArray pythonCommands = { "python3", "python" };
+            for (const auto& cmd : pythonCommands)
+            {
+                juce::ChildProcess process;
+                if (process.start (cmd + " --version"))
+                {
+                    process.waitForProcessToFinish (500);
+                    cachedPythonCommand = cmd;
+                    cachedScriptPath = script.getFullPathName();
+                    available = true;
+                    return;
+                }
+            }
+        });
+
+        onnxExecutablePath = cachedExecutablePath;
+        pythonCommand = cachedPythonCommand;
+        pythonScriptPath = cachedScriptPath;
+        return available;
+    }
+
+    // Canonical 44-byte RIFF/PCM header with every format field evaluated at
+    // compile time; only the two size fields depend on the sample count.
+    template <juce::uint32 sampleRate, juce::uint16 numChannels, juce::uint16 bitsPerSample>
+    struct WavHeader
+    {
+        explicit constexpr WavHeader (juce::uint32 numSamples)
+        {
+            constexpr juce::uint16 blockAlign = numChannels * bitsPerSample / 8;
+            constexpr juce::uint32 byteRate = sampleRate * blockAlign;
+            const juce::uint32 dataBytes = numSamples * blockAlign;
+
+            writeTag (0, "RIFF");
+            writeUint32 (4, 36 + dataBytes);
+            writeTag (8, "WAVE");
+            writeTag (12, "fmt ");
+            writeUint32 (16, 16);               // fmt chunk size
+            writeUint16 (20, 1);                // PCM
+            writeUint16 (22, numChannels);
+            writeUint32 (24, sampleRate);
+            writeUint32 (28, byteRate);
+            writeUint16 (32, blockAlign);
+            writeUint16 (34, bitsPerSample);
+            writeTag (36, "data");
+            writeUint32 (40, dataBytes);
+        }
+
+        constexpr void writeTag (size_t pos, const char (&tag)[5])
+        {
+            for (size_t i = 0; i < 4; ++i)
+                bytes[pos + i] = (juce::uint8) tag[i];
+        }
+
+        constexpr void writeUint16 (size_t pos, juce::uint16 value)
+        {
+            bytes[pos] = (juce::uint8) (value & 0xff);
+            bytes[pos + 1] = (juce::uint8) (value >> 8);
+        }
+
+        constexpr void writeUint32 (size_t pos, juce::uint32 value)
+        {
+            for (size_t i = 0; i < 4; ++i)
+                bytes[pos + i] = (juce::uint8) ((value >> (8 * i)) & 0xff);
         }
 
-        juce::StringArray pythonCommands = { "python3", "python" };
-        for (const auto& cmd : pythonCommands)
+        std::array<juce::uint8, 44> bytes {};
+    };
+
+    // Samples per write block for both audio writers: 1 MB of float input,
+    // small enough that polling isAborted between blocks makes an abort
+    // during an hour-long write feel immediate. The TemporaryFile owning the
+    // target deletes the partial file on every exit path.
+    static constexpr size_t writeBlockSamples = (1 << 20) / sizeof (float);
+
+    template <typename IsAborted>
+    bool writeFlacFile (const juce::File& file, const std::vector<float>& audioData, int sampleRate,
+                        IsAborted&& isAborted)
+    {
+        try
         {
-            juce::ChildProcess process;
-            if (process.start (cmd + " --version"))
+            juce::FlacAudioFormat flacFormat;
+            auto fileStream = file.createOutputStream();
+
+            if (fileStream == nullptr)
+                return false;
+
+            fileStream->setPosition (0);
+            fileStream->truncate();
+
+            // The FLAC encoder emits many small writes; a 256 KB buffer
+            // collapses them into a handful of write syscalls.
+            auto outputStream = std::make_unique<juce::BufferedOutputStream> (
+                juce::OptionalScopedPointer<juce::OutputStream> (fileStream.release(), true), 256 * 1024);
+
+            // Quality index 0 is the fastest FLAC compression level.
+            std::unique_ptr<juce::AudioFormatWriter> writer (
+                flacFormat.createWriterFor (outputStream.get(), sampleRate, 1, 16, {}, 0));
+
+            if (writer == nullptr)
+                return false;
+
+            outputStream.release(); // now owned by the writer
+
+            for (size_t offset = 0; offset < audioData.size(); offset += writeBlockSamples)
             {
-                process.waitForProcessToFinish (2000);
-                pythonCommand = cmd;
-                return true;
+                if (isAborted())
+                    return false;
+
+                const auto count = std::min (writeBlockSamples, audioData.size() - offset);
+                const float* channels[1] = { audioData.data() + offset };
+
+                if (! writer->writeFromFloatArrays (channels, 1, (int) count))
+                    return false;
             }
-        }
 
-        return false;
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
     }
 
-    bool writeWavFile (const juce::File& file, const std::vector<float>& audioData, int sampleRate)
+    template <typename IsAborted>
+    bool writeWavFile (const juce::File& file, const std::vector<float>& audioData, int sampleRate,
+                       IsAborted&& isAborted)
     {
+        // The handoff format is fixed at 16 kHz mono 16-bit.
+        jassert (sampleRate == 16000);
+        juce::ignoreUnused (sampleRate);
+
         try
         {
-            juce::AudioBuffer<float> buffer (1, static_cast<int> (audioData.size()));
-            buffer.copyFrom (0, 0, audioData.data(), static_cast<int> (audioData.size()));
+            const auto numSamples = audioData.size();
+
+            // Quantize in a single pass over the caller's contiguous data.
+            // The clamped loop autovectorizes; going through JUCE's
+            // AudioFormatWriter would add an AudioBuffer copy plus a
+            // per-sample virtual conversion.
+            std::vector<juce::int16> pcm (numSamples);
 
-            juce::WavAudioFormat wavFormat;
-            auto outputStream = file.createOutputStream();
+            for (size_t i = 0; i < numSamples; ++i)
+                pcm[i] = (juce::int16) juce::jlimit (-32768.0f, 32767.0f, audioData[i] * 32767.0f);
 
-            if (outputStream == nullptr)
+            const auto dataBytes = numSamples * sizeof (juce::int16);
+
+            juce::FileOutputStream stream (file);
+            if (stream.failedToOpen())
                 return false;
 
-            std::unique_ptr<juce::AudioFormatWriter> writer (
-                wavFormat.createWriterFor (outputStream.release(), sampleRate, 1, 16, {}, 0));
+            // FileOutputStream opens positioned at the end, and this writer
+            // runs as the fallback after a failed FLAC attempt may have left
+            // partial data in the same temp file - start from a clean slate.
+            stream.setPosition (0);
+            stream.truncate();
 
-            if (writer == nullptr)
+            const WavHeader<16000, 1, 16> header ((juce::uint32) numSamples);
+
+            if (! stream.write (header.bytes.data(), header.bytes.size()))
                 return false;
 
-            return writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+            const auto* pcmBytes = reinterpret_cast<const char*> (pcm.data());
+            constexpr size_t blockBytes = writeBlockSamples * sizeof (float);
+
+            for (size_t offset = 0; offset < dataBytes; offset += blockBytes)
+            {
+                if (isAborted())
+                    return false;
+
+                if (! stream.write (pcmBytes + offset, std::min (blockBytes, dataBytes - offset)))
+                    return false;
+            }
+
+            return stream.getStatus().wasOk();
         }
         catch (...)
         {
@@ -248,7 +554,15 @@ private:
         }
     }
 
-    juce::String runPythonTranscription (const juce::String& audioFilePath, std::function<bool ()> isAborted)
+    // Runs the transcription process and feeds each complete, trimmed,
+    // non-empty output line to handleLine as it arrives, so parsing (and
+    // progress reporting) overlaps the child's inference instead of waiting
+    // for EOF. Returns false on abort, a reported error, or a bad exit code.
+    template <typename IsAborted, typename LineHandler>
+    bool runPythonTranscription (const juce::String& audioFilePath,
+                                 const juce::String& quantization,
+                                 IsAborted&& isAborted,
+                                 LineHandler&& handleLine)
     {
         juce::StringArray args;
 
@@ -256,72 +570,138 @@ private:
         if (modelForPython.startsWith ("onnx-"))
             modelForPython = modelForPython.substring (5);
 
-        if (onnxExecutablePath.isEmpty())
+        if (onnxExecutablePath.isNotEmpty())
+        {
+            args.add (onnxExecutablePath);
+        }
+        else if (pythonCommand.isNotEmpty() && pythonScriptPath.isNotEmpty())
+        {
+            args.add (pythonCommand);
+            args.add (pythonScriptPath);
+        }
+        else
         {
             logToConsole ("Parakeet: Executable not found");
-            return {};
+            return false;
         }
 
-        args.add (onnxExecutablePath);
         args.add (audioFilePath);
         args.add ("--model");
         args.add (modelForPython);
 
+        if (quantization.isNotEmpty())
+        {
+            args.add ("--quantization");
+            args.add (quantization);
+        }
+
         juce::ChildProcess process;
         if (! process.start (args))
-            return {};
+            return false;
+
+        progress.store (25, std::memory_order_relaxed);
 
-        progress.store (50);
+        // Only incomplete trailing lines are buffered between reads; whole
+        // lines are handed out immediately.
+        std::string pending;
+        pending.reserve (65536);
 
-        // Read output incrementally while process runs to avoid buffer overflow
-        juce::String output;
+        // Sized to the default pipe capacity on Linux, so a full pipe is
+        // drained in one read instead of sixteen.
+        char buffer[65536];
 
-        while (process.isRunning())
+        size_t totalBytes = 0;
+        bool reportedError = false;
+
+        auto dispatchLines = [&]
+        {
+            size_t lineStart = 0;
+
+            for (;;)
+            {
+                const auto lineEnd = pending.find ('\n', lineStart);
+                if (lineEnd == std::string::npos)
+                    break;
+
+                const auto line = trimmedView (std::string_view (pending.data() + lineStart, lineEnd - lineStart));
+                lineStart = lineEnd + 1;
+
+                if (line.empty())
+                    continue;
+
+                // Error lines are caught as they arrive rather than by
+                // re-scanning the whole output after the fact.
+                if (line.size() >= 6 && line.compare (0, 6, "ERROR:") == 0)
+                {
+                    reportedError = true;
+                    logToConsole ("Parakeet error: " + juce::String::fromUTF8 (line.data(), (int) line.size()));
+                    continue;
+                }
+
+                handleLine (line);
+            }
+
+            pending.erase (0, lineStart);
+        };
+
+        // readProcessOutput blocks until the child produces data or closes
+        // its end of the pipe, so the loop wakes when there is something to
+        // consume instead of sleeping on a fixed 200 ms timer.
+        for (;;)
         {
             if (isAborted())
             {
                 process.kill();
-                return {};
+                return false;
             }
 
-            // Read any available output to prevent buffer from filling up
-            char buffer[4096];
-            int bytesRead = process.readProcessOutput(buffer, sizeof(buffer));
+            const int bytesRead = process.readProcessOutput (buffer, sizeof (buffer));
+
             if (bytesRead > 0)
-                output += juce::String::fromUTF8(buffer, bytesRead);
+            {
+                pending.append (buffer, (size_t) bytesRead);
+                totalBytes += (size_t) bytesRead;
+                dispatchLines();
+                continue;
+            }
+
+            if (! process.isRunning())
+                break;
 
-            juce::Thread::sleep (200);
+            // Defensive: a zero-byte read while the child is still alive
+            // should not happen with blocking pipes, but avoid spinning.
+            juce::Thread::sleep (5);
+        }
+
+        // Flush a final line without a trailing newline.
+        if (! pending.empty())
+        {
+            pending.push_back ('\n');
+            dispatchLines();
         }
 
-        // Read any remaining output
-        auto remaining = process.readAllProcessOutput();
-        if (remaining.isNotEmpty())
-            output += remaining;
+        process.waitForProcessToFinish (5000);
 
-        progress.store (80);
+        logToConsole ("Parakeet: Received " + juce::String (totalBytes) + " bytes of output");
 
-        // Check exit code
-        auto exitCode = process.getExitCode();
+        const auto exitCode = process.getExitCode();
         if (exitCode != 0)
         {
             logToConsole ("Parakeet process exited with code: " + juce::String (exitCode));
-            logToConsole ("Output: " + output);
-            return {};
+            return false;
         }
 
-        // Check for errors
-        if (output.startsWith ("ERROR:") || output.contains ("ERROR:"))
-        {
-            logToConsole ("Parakeet error: " + output);
-            return {};
-        }
+        return ! reportedError;
+    }
 
-        return output.trim();
+    bool canLogToConsole() const noexcept
+    {
+        return reaperProxy != nullptr && reaperProxy->has (ReaperProxy::Fn::ShowConsoleMsg);
     }
 
     void logToConsole (const juce::String& message)
     {
-        if (reaperProxy && reaperProxy->hasShowConsoleMsg)
+        if (canLogToConsole())
         {
             try
             {
@@ -334,8 +714,10 @@ private:
     std::string modelsDir;
     std::string lastModelName;
     juce::String pythonCommand = "python3";
+    juce::String pythonScriptPath;
     juce::String onnxExecutablePath;
     ReaperProxy* reaperProxy = nullptr;
-    std::atomic<int> progress { 0 };
-    std::atomic<double> processingTimeSeconds { 0.0 };
+    ASRResultCache resultCache;
+    alignas (64) std::atomic<int> progress { 0 };
+    alignas (64) std::atomic<double> processingTimeSeconds { 0.0 };
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <exception>
 #include <juce_core/juce_core.h>
 
@@ -16,6 +17,88 @@ struct ReaperProxy
         const char* functionName;
     };
 
+    // One slot per wrapped REAPER API function. The resolved pointers live in
+    // a single contiguous array indexed by this enum instead of thirty
+    // scattered members, so availability checks and calls touch one cache
+    // line group.
+    enum class Fn : size_t
+    {
+        AddMediaItemToTrack,
+        AddProjectMarker2,
+        AddTakeToMediaItem,
+        CountMediaItems,
+        CountSelectedTracks,
+        GetActiveTake,
+        GetCursorPositionEx,
+        GetItemStateChunk,
+        GetLastTouchedTrack,
+        GetMediaItem,
+        GetMediaItemInfo_Value,
+        GetMediaItemTake_Source,
+        GetMediaSourceFileName,
+        GetProjectStateChangeCount,
+        GetSelectedMediaItem,
+        GetSelectedTrack,
+        SetMediaItemTakeInfo_Value,
+        GetSetMediaTrackInfo_String,
+        GetTrack,
+        InsertTrackInProject,
+        Main_OnCommandEx,
+        PCM_Source_CreateFromFile,
+        PreventUIRefresh,
+        SelectAllMediaItems,
+        SetEditCurPos2,
+        SetItemStateChunk,
+        SetMediaItemLength,
+        SetMediaItemPosition,
+        SetMediaItemTake_Source,
+        SetOnlyTrackSelected,
+        SetTakeMarker,
+        ShowConsoleMsg,
+        Undo_BeginBlock2,
+        Undo_EndBlock2,
+        count // Used for array size
+    };
+
+    // API names in Fn order, so load() is one loop over the table instead of
+    // a copy-pasted lookup line per function.
+    static constexpr std::array<const char*, static_cast<size_t> (Fn::count)> fnNames = {
+        "AddMediaItemToTrack",
+        "AddProjectMarker2",
+        "AddTakeToMediaItem",
+        "CountMediaItems",
+        "CountSelectedTracks",
+        "GetActiveTake",
+        "GetCursorPositionEx",
+        "GetItemStateChunk",
+        "GetLastTouchedTrack",
+        "GetMediaItem",
+        "GetMediaItemInfo_Value",
+        "GetMediaItemTake_Source",
+        "GetMediaSourceFileName",
+        "GetProjectStateChangeCount",
+        "GetSelectedMediaItem",
+        "GetSelectedTrack",
+        "SetMediaItemTakeInfo_Value",
+        "GetSetMediaTrackInfo_String",
+        "GetTrack",
+        "InsertTrackInProject",
+        "Main_OnCommandEx",
+        "PCM_Source_CreateFromFile",
+        "PreventUIRefresh",
+        "SelectAllMediaItems",
+        "SetEditCurPos2",
+        "SetItemStateChunk",
+        "SetMediaItemLength",
+        "SetMediaItemPosition",
+        "SetMediaItemTake_Source",
+        "SetOnlyTrackSelected",
+        "SetTakeMarker",
+        "ShowConsoleMsg",
+        "Undo_BeginBlock2",
+        "Undo_EndBlock2",
+    };
+
     ReaperProxy() {}
 
     void load(reaper::IReaperHostApplication* reaperHost)
@@ -23,40 +106,14 @@ struct ReaperProxy
         if (reaperHost == nullptr)
             return;
 
-        hasAddMediaItemToTrack = reaperHost->getReaperApi("AddMediaItemToTrack");
-        hasAddProjectMarker2 = reaperHost->getReaperApi("AddProjectMarker2");
-        hasAddTakeToMediaItem = reaperHost->getReaperApi("AddTakeToMediaItem");
-        hasCountMediaItems = reaperHost->getReaperApi("CountMediaItems");
-        hasCountSelectedTracks = reaperHost->getReaperApi("CountSelectedTracks");
-        hasCountMediaItems = reaperHost->getReaperApi("CountMediaItems");
-        hasGetActiveTake = reaperHost->getReaperApi("GetActiveTake");
-        hasGetCursorPositionEx = reaperHost->getReaperApi("GetCursorPositionEx");
-        hasGetItemStateChunk = reaperHost->getReaperApi("GetItemStateChunk");
-        hasGetLastTouchedTrack = reaperHost->getReaperApi("GetLastTouchedTrack");
-        hasGetMediaItem = reaperHost->getReaperApi("GetMediaItem");
-        hasGetMediaItemInfo_Value = reaperHost->getReaperApi("GetMediaItemInfo_Value");
-        hasGetMediaItemTake_Source = reaperHost->getReaperApi("GetMediaItemTake_Source");
-        hasGetMediaSourceFileName = reaperHost->getReaperApi("GetMediaSourceFileName");
-        hasGetSelectedMediaItem = reaperHost->getReaperApi("GetSelectedMediaItem");
-        hasGetSelectedTrack = reaperHost->getReaperApi("GetSelectedTrack");
-        hasSetMediaItemTakeInfo_Value = reaperHost->getReaperApi("SetMediaItemTakeInfo_Value");
-        hasGetSetMediaTrackInfo_String = reaperHost->getReaperApi("GetSetMediaTrackInfo_String");
-        hasGetTrack = reaperHost->getReaperApi("GetTrack");
-        hasInsertTrackInProject = reaperHost->getReaperApi("InsertTrackInProject");
-        hasMain_OnCommandEx = reaperHost->getReaperApi("Main_OnCommandEx");
-        hasPCM_Source_CreateFromFile = reaperHost->getReaperApi("PCM_Source_CreateFromFile");
-        hasPreventUIRefresh = reaperHost->getReaperApi("PreventUIRefresh");
-        hasSelectAllMediaItems = reaperHost->getReaperApi("SelectAllMediaItems");
-        hasSetEditCurPos2 = reaperHost->getReaperApi("SetEditCurPos2");
-        hasSetItemStateChunk = reaperHost->getReaperApi("SetItemStateChunk");
-        hasSetMediaItemLength = reaperHost->getReaperApi("SetMediaItemLength");
-        hasSetMediaItemPosition = reaperHost->getReaperApi("SetMediaItemPosition");
-        hasSetMediaItemTake_Source = reaperHost->getReaperApi("SetMediaItemTake_Source");
-        hasSetOnlyTrackSelected = reaperHost->getReaperApi("SetOnlyTrackSelected");
-        hasSetTakeMarker = reaperHost->getReaperApi("SetTakeMarker");
-        hasShowConsoleMsg = reaperHost->getReaperApi("ShowConsoleMsg");
-        hasUndo_BeginBlock2 = reaperHost->getReaperApi("Undo_BeginBlock2");
-        hasUndo_EndBlock2 = reaperHost->getReaperApi("Undo_EndBlock2");
+        for (size_t i = 0; i < fnNames.size(); ++i)
+            table[i] = reaperHost->getReaperApi (fnNames[i]);
+    }
+
+    // Whether the host resolved the given API function.
+    bool has (Fn fn) const noexcept
+    {
+        return table[static_cast<size_t> (fn)] != nullptr;
     }
 
     class MediaItem;
@@ -70,205 +127,176 @@ struct ReaperProxy
     JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wgnu-zero-variadic-macro-arguments")
 
 #define REAPER_CALL(functionName, typ, ...) \
-    if (has##functionName) \
-        return reinterpret_cast<typ> (has##functionName) (__VA_ARGS__); \
+    if (auto* fn = table[static_cast<size_t> (Fn::functionName)]) \
+        return reinterpret_cast<typ> (fn) (__VA_ARGS__); \
     else \
         throw Missing (#functionName);
 
-    void* hasAddMediaItemToTrack = nullptr;
     MediaItem* AddMediaItemToTrack (MediaTrack* tr)
     {
         REAPER_CALL(AddMediaItemToTrack, MediaItem* (*) (MediaTrack*), tr)
     }
 
-    void* hasAddProjectMarker2 = nullptr;
     int AddProjectMarker2 (ReaProject* proj, bool isrgn, double pos, double rgnend, const char* name, int wantidx, int color)
     {
         REAPER_CALL(AddProjectMarker2, int (*) (ReaProject*, bool, double, double, const char*, int, int), proj, isrgn, pos, rgnend, name, wantidx, color)
     }
 
-    void* hasAddTakeToMediaItem = nullptr;
     MediaTake* AddTakeToMediaItem (MediaItem* item)
     {
         REAPER_CALL(AddTakeToMediaItem, MediaTake* (*) (MediaItem*), item)
     }
 
-    void* hasCountMediaItems = nullptr;
     int CountMediaItems (ReaProject* proj)
     {
         REAPER_CALL(CountMediaItems, int (*) (ReaProject*), proj)
     }
 
-    void* hasCountSelectedTracks = nullptr;
     int CountSelectedTracks (ReaProject* proj)
     {
         REAPER_CALL(CountSelectedTracks, int (*) (ReaProject*), proj)
     }
 
-    void* hasGetActiveTake = nullptr;
     MediaTake* GetActiveTake (MediaItem* item)
     {
         REAPER_CALL(GetActiveTake, MediaTake* (*) (MediaItem*), item)
     }
 
-    void* hasGetCursorPositionEx = nullptr;
     double GetCursorPositionEx (ReaProject* proj)
     {
         REAPER_CALL(GetCursorPositionEx, double (*) (ReaProject*), proj)
     }
 
-    void* hasGetItemStateChunk = nullptr;
     bool GetItemStateChunk (MediaItem* item, char* strNeedBig, int strNeedBig_sz, bool isundoOptional)
     {
         REAPER_CALL(GetItemStateChunk, bool (*) (MediaItem*, char*, int, bool), item, strNeedBig, strNeedBig_sz, isundoOptional)
     }
 
-    void* hasGetLastTouchedTrack = nullptr;
     MediaTrack* GetLastTouchedTrack ()
     {
         REAPER_CALL(GetLastTouchedTrack, MediaTrack* (*) ())
     }
 
-    void* hasGetMediaItem = nullptr;
     MediaItem* GetMediaItem (ReaProject* proj, int itemidx)
     {
         REAPER_CALL(GetMediaItem, MediaItem* (*) (ReaProject*, int), proj, itemidx)
     }
 
-    class PCM_source;
-    void* hasGetMediaItemInfo_Value = nullptr;
     double GetMediaItemInfo_Value (MediaItem* item, const char* parmname)
     {
         REAPER_CALL(GetMediaItemInfo_Value, double (*) (MediaItem*, const char*), item, parmname)
     }
 
-    void* hasGetMediaItemTake_Source = nullptr;
     PCM_source* GetMediaItemTake_Source (MediaTake* take)
     {
         REAPER_CALL(GetMediaItemTake_Source, PCM_source* (*) (MediaTake*), take)
     }
 
-    void* hasGetMediaSourceFileName = nullptr;
     void GetMediaSourceFileName (PCM_source* source, char* filenamebuf, int filenamebuf_sz)
     {
         REAPER_CALL(GetMediaSourceFileName, void (*) (PCM_source*, char*, int), source, filenamebuf, filenamebuf_sz)
     }
 
-    void* hasGetSelectedMediaItem = nullptr;
+    int GetProjectStateChangeCount (ReaProject* proj)
+    {
+        REAPER_CALL(GetProjectStateChangeCount, int (*) (ReaProject*), proj)
+    }
+
     MediaItem* GetSelectedMediaItem (ReaProject* proj, int selitem)
     {
         REAPER_CALL(GetSelectedMediaItem, MediaItem* (*) (ReaProject*, int), proj, selitem)
     }
 
-    void* hasGetSelectedTrack = nullptr;
     MediaTrack* GetSelectedTrack (ReaProject* proj, int seltrackidx)
     {
         REAPER_CALL(GetSelectedTrack, MediaTrack* (*) (ReaProject*, int), proj, seltrackidx)
     }
 
-    void* hasSetMediaItemTakeInfo_Value = nullptr;
     bool SetMediaItemTakeInfo_Value (MediaTake* take, const char* parmname, double newvalue)
     {
         REAPER_CALL(SetMediaItemTakeInfo_Value, bool (*) (MediaTake*, const char*, double), take, parmname, newvalue)
     }
 
-    void* hasGetSetMediaTrackInfo_String = nullptr;
     bool GetSetMediaTrackInfo_String (MediaTrack* tr, const char* parmname, char* stringNeedBig, bool setNewValue)
     {
         REAPER_CALL(GetSetMediaTrackInfo_String, bool (*) (MediaTrack*, const char*, char*, bool), tr, parmname, stringNeedBig, setNewValue)
     }
 
-    void* hasGetTrack = nullptr;
     MediaTrack* GetTrack (ReaProject* proj, int trackidx)
     {
         REAPER_CALL(GetTrack, MediaTrack* (*) (ReaProject*, int), proj, trackidx)
     }
 
-    void* hasInsertTrackInProject = nullptr;
     MediaTrack* InsertTrackInProject (ReaProject* proj, int idx, int flags)
     {
         REAPER_CALL(InsertTrackInProject, MediaTrack* (*) (ReaProject*, int, int), proj, idx, flags)
     }
 
-    void* hasMain_OnCommandEx = nullptr;
     void Main_OnCommandEx (int command, int flag, ReaProject* proj)
     {
         REAPER_CALL(Main_OnCommandEx, void (*) (int, int, ReaProject*), command, flag, proj)
     }
 
-    void* hasPCM_Source_CreateFromFile = nullptr;
     PCM_source* PCM_Source_CreateFromFile (const char* filename)
     {
         REAPER_CALL(PCM_Source_CreateFromFile, PCM_source* (*) (const char*), filename)
     }
 
-    void* hasPreventUIRefresh = nullptr;
     void PreventUIRefresh (int state)
     {
         REAPER_CALL(PreventUIRefresh, void (*) (int), state)
     }
 
-    void* hasSelectAllMediaItems = nullptr;
     void SelectAllMediaItems (ReaProject* proj, bool selected)
     {
         REAPER_CALL(SelectAllMediaItems, void (*) (ReaProject*, bool), proj, selected)
     }
 
-    void* hasSetEditCurPos2 = nullptr;
     void SetEditCurPos2 (ReaProject* proj, double time, bool moveview, bool seekplay)
     {
         REAPER_CALL(SetEditCurPos2, void (*) (ReaProject*, double, bool, bool), proj, time, moveview, seekplay)
     }
 
-    void* hasSetItemStateChunk = nullptr;
     bool SetItemStateChunk (MediaItem* item, const char* str, bool isundoOptional)
     {
         REAPER_CALL(SetItemStateChunk, bool (*) (MediaItem*, const char*, bool), item, str, isundoOptional)
     }
 
-    void* hasSetMediaItemLength = nullptr;
     void SetMediaItemLength (MediaItem* item, double length, bool refreshUI)
     {
         REAPER_CALL(SetMediaItemLength, void (*) (MediaItem*, double, bool), item, length, refreshUI)
     }
 
-    void* hasSetMediaItemPosition = nullptr;
     void SetMediaItemPosition (MediaItem* item, double position, bool refreshUI)
     {
         REAPER_CALL(SetMediaItemPosition, void (*) (MediaItem*, double, bool), item, position, refreshUI)
     }
 
-    void* hasSetMediaItemTake_Source = nullptr;
     bool SetMediaItemTake_Source (MediaTake* take, PCM_source* source)
     {
         REAPER_CALL(SetMediaItemTake_Source, bool (*) (MediaTake*, PCM_source*), take, source)
     }
 
-    void* hasSetOnlyTrackSelected = nullptr;
     void SetOnlyTrackSelected (MediaTrack* track)
     {
         REAPER_CALL(SetOnlyTrackSelected, void (*) (MediaTrack*), track)
     }
 
-    void* hasSetTakeMarker = nullptr;
     int SetTakeMarker (MediaTake* take, int idx, const char* name, double* srcpos, int* color)
     {
         REAPER_CALL(SetTakeMarker, int (*) (MediaTake*, int, const char*, double*, int*), take, idx, name, srcpos, color)
     }
 
-    void* hasShowConsoleMsg = nullptr;
     void ShowConsoleMsg (const char* msg)
     {
         REAPER_CALL(ShowConsoleMsg, void (*) (const char*), msg)
     }
 
-    void* hasUndo_BeginBlock2 = nullptr;
     void Undo_BeginBlock2(ReaProject* proj)
     {
         REAPER_CALL(Undo_BeginBlock2, void (*) (ReaProject*), proj)
     }
 
-    void* hasUndo_EndBlock2 = nullptr;
     void Undo_EndBlock2 (ReaProject* proj, const char* descchange, int extraflags)
     {
         REAPER_CALL(Undo_EndBlock2, void (*) (ReaProject*, const char*, int), proj, descchange, extraflags)
@@ -279,5 +307,7 @@ struct ReaperProxy
     JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
 private:
+    std::array<void*, static_cast<size_t> (Fn::count)> table {};
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReaperProxy)
 };
@@ -401,10 +401,14 @@ export default class App {
   }
 
   update() {
-    return Promise.all([
-      this.updateTranscriptionStatus(),
-      this.updatePlaybackRegions(),
-    ]);
+    // One bundled poll instead of separate status and play head round trips;
+    // the individual endpoints remain for direct calls.
+    return this.native.getStatusBundle().then((bundle) => {
+      return Promise.all([
+        this.updateTranscriptionStatus(bundle.transcription),
+        this.updatePlaybackRegions(bundle.playHead),
+      ]);
+    });
   }
 
   updateAudioSources() {
@@ -418,12 +422,15 @@ export default class App {
     });
   }
 
-  updateTranscriptionStatus() {
+  updateTranscriptionStatus(transcriptionStatus?: { status: string, progress: number }) {
     if (!this.processing) {
       this.setProgress(0);
       return Promise.resolve();
     }
-    return this.native.getTranscriptionStatus().then((status) => {
+    const statusPromise = transcriptionStatus
+      ? Promise.resolve(transcriptionStatus)
+      : this.native.getTranscriptionStatus();
+    return statusPromise.then((status) => {
       if (status.status !== '') {
         this.setProcessText(status.status + '...');
       }
@@ -431,13 +438,16 @@ export default class App {
     });
   }
 
-  updatePlaybackRegions() {
+  updatePlaybackRegions(playHead?: { timeInSeconds: number, isPlaying: boolean }) {
     return this.native.getRegionSequences().then((regionSequences: RegionSequence[]) => {
       const playbackRegionsByAudioSource =
         this.collectPlaybackRegionsByAudioSource(regionSequences);
       this.transcriptGrid.setPlaybackRegionMap(playbackRegionsByAudioSource);
 
-      return this.native.getPlayHeadState().then((playHeadState) => {
+      const playHeadPromise = playHead
+        ? Promise.resolve(playHead)
+        : this.native.getPlayHeadState();
+      return playHeadPromise.then((playHeadState) => {
         this.transcriptGrid.setPlaybackPosition(playHeadState.timeInSeconds, playHeadState.isPlaying);
       });
     });
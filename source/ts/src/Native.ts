@@ -10,6 +10,7 @@ export default class Native {
   getPlayHeadState = Juce.getNativeFunction("getPlayHeadState");
   getProcessingTime = Juce.getNativeFunction("getProcessingTime");
   getRegionSequences = Juce.getNativeFunction("getRegionSequences");
+  getStatusBundle = Juce.getNativeFunction("getStatusBundle");
   getTranscriptionStatus = Juce.getNativeFunction("getTranscriptionStatus");
   getWhisperLanguages = Juce.getNativeFunction("getWhisperLanguages");
   insertAudioAtCursor = Juce.getNativeFunction("insertAudioAtCursor");
@@ -14,6 +14,7 @@ export class MockNative {
   public getPlayHeadState: jest.Mock;
   public getProcessingTime: jest.Mock;
   public getRegionSequences: jest.Mock;
+  public getStatusBundle: jest.Mock;
   public getTranscriptionStatus: jest.Mock;
   public getWhisperLanguages: jest.Mock;
   public insertAudioAtCursor: jest.Mock;
@@ -39,6 +40,7 @@ export class MockNative {
     this.getPlayHeadState = this.createMock('getPlayHeadState');
     this.getProcessingTime = this.createMock('getProcessingTime');
     this.getRegionSequences = this.createMock('getRegionSequences');
+    this.getStatusBundle = this.createMock('getStatusBundle');
     this.getTranscriptionStatus = this.createMock('getTranscriptionStatus');
     this.getWhisperLanguages = this.createMock('getWhisperLanguages');
     this.insertAudioAtCursor = this.createMock('insertAudioAtCursor');
@@ -110,6 +112,11 @@ export class MockNative {
     this.getPlayHeadState.mockReturnValue(Promise.resolve({"timeInSeconds": 0, "isPlaying": false}));
     this.getProcessingTime.mockReturnValue(Promise.resolve(0));
     this.getRegionSequences.mockReturnValue(Promise.resolve([]));
+    this.getStatusBundle.mockReturnValue(Promise.resolve({
+      "transcription": {"status": "", "progress": 0},
+      "playHead": {"timeInSeconds": 0, "isPlaying": false},
+      "processingTime": 0
+    }));
     this.getTranscriptionStatus.mockReturnValue(Promise.resolve({"status": "", "progress": 0}));
     this.getWhisperLanguages.mockReturnValue(Promise.resolve([]));
     this.insertAudioAtCursor.mockReturnValue(Promise.resolve());
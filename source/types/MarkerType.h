@@ -25,16 +25,28 @@ struct MarkerType
 
     static std::optional<Enum> fromString (const std::string& str)
     {
-        for (size_t i = 0; i < strings.size(); ++i)
-            if (str == strings[i])
-                return static_cast<Enum> (i);
+        // All four names disambiguate on their first character, so one
+        // switch plus a single full comparison replaces the linear scan.
+        if (str.empty())
+            return std::nullopt;
+
+        switch (str.front())
+        {
+            case 'm': if (str == strings[markers])     return markers;     break;
+            case 'r': if (str == strings[regions])     return regions;     break;
+            case 'n': if (str == strings[notes])       return notes;       break;
+            case 't': if (str == strings[takemarkers]) return takemarkers; break;
+            default: break;
+        }
+
         return std::nullopt;
     }
 
-    static std::string toString (Enum type)
+    // Returns a view into the static name table (empty when out of range);
+    // no allocation, and usable in constexpr contexts.
+    static constexpr std::string_view toString (Enum type) noexcept
     {
-        if (type >= 0 && type < count)
-            return std::string (strings[type]);
-        return "";
+        const auto index = static_cast<size_t> (type);
+        return index < strings.size() ? strings[index] : std::string_view();
     }
 };
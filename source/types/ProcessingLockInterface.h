@@ -1,9 +1,41 @@
 #pragma once
 
-#include <juce_core/juce_core.h>
+#include <shared_mutex>
+
+// Non-blocking shared (reader) guard over a std::shared_mutex. The audio
+// thread takes one of these per block and must never block on the edit lock,
+// so acquisition is try-only and the caller checks isLocked().
+class TryReadGuard
+{
+public:
+    explicit TryReadGuard (std::shared_mutex& mutexIn)
+        : mutex (mutexIn), locked (mutexIn.try_lock_shared()) {}
+
+    TryReadGuard (TryReadGuard&& other) noexcept
+        : mutex (other.mutex), locked (other.locked)
+    {
+        other.locked = false;
+    }
+
+    TryReadGuard (const TryReadGuard&) = delete;
+    TryReadGuard& operator= (const TryReadGuard&) = delete;
+    TryReadGuard& operator= (TryReadGuard&&) = delete;
+
+    ~TryReadGuard()
+    {
+        if (locked)
+            mutex.unlock_shared();
+    }
+
+    bool isLocked() const noexcept { return locked; }
+
+private:
+    std::shared_mutex& mutex;
+    bool locked;
+};
 
 struct ProcessingLockInterface
 {
     virtual ~ProcessingLockInterface() = default;
-    virtual juce::ScopedTryReadLock getProcessingLock() = 0;
+    virtual TryReadGuard getProcessingLock() = 0;
 };
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
@@ -39,46 +45,55 @@ public:
 
     juce::WebBrowserComponent::Options buildOptions (const juce::WebBrowserComponent::Options& initialOptions)
     {
-        auto bindFn = [this] (auto memberFn)
-        {
-            return [this, memberFn] (const auto& args, const auto& complete)
-            {
-                (this->*memberFn) (args, complete);
-            };
+        using MemberFn = void (NativeFunctions::*) (const juce::var&, std::function<void (const juce::var&)>);
+
+        // Name -> member function table. Binding is one loop over a static
+        // table with a single trampoline shape, instead of a bespoke closure
+        // per function.
+        static constexpr std::pair<const char*, MemberFn> bindings[] = {
+            { "abortTranscription", &NativeFunctions::abortTranscription },
+            { "canCreateMarkers", &NativeFunctions::canCreateMarkers },
+            { "createMarkers", &NativeFunctions::createMarkers },
+            { "getAudioSources", &NativeFunctions::getAudioSources },
+            { "getAudioSourceTranscript", &NativeFunctions::getAudioSourceTranscript },
+            { "getModels", &NativeFunctions::getModels },
+            { "getPlayHeadState", &NativeFunctions::getPlayHeadState },
+            { "getProcessingTime", &NativeFunctions::getProcessingTime },
+            { "getRegionSequences", &NativeFunctions::getRegionSequences },
+            { "getStatusBundle", &NativeFunctions::getStatusBundle },
+            { "getTranscriptionStatus", &NativeFunctions::getTranscriptionStatus },
+            { "getWhisperLanguages", &NativeFunctions::getWhisperLanguages },
+            { "insertAudioAtCursor", &NativeFunctions::insertAudioAtCursor },
+            { "play", &NativeFunctions::play },
+            { "stop", &NativeFunctions::stop },
+            { "saveFile", &NativeFunctions::saveFile },
+            { "setAudioSourceTranscript", &NativeFunctions::setAudioSourceTranscript },
+            { "setDebugMode", &NativeFunctions::setDebugMode },
+            { "setPlaybackPosition", &NativeFunctions::setPlaybackPosition },
+            { "setWebState", &NativeFunctions::setWebState },
+            { "transcribeAudioSource", &NativeFunctions::transcribeAudioSource },
         };
 
-        return initialOptions
-            .withNativeFunction ("abortTranscription", bindFn (&NativeFunctions::abortTranscription))
-            .withNativeFunction ("canCreateMarkers", bindFn (&NativeFunctions::canCreateMarkers))
-            .withNativeFunction ("createMarkers", bindFn (&NativeFunctions::createMarkers))
-            .withNativeFunction ("getAudioSources", bindFn (&NativeFunctions::getAudioSources))
-            .withNativeFunction ("getAudioSourceTranscript", bindFn (&NativeFunctions::getAudioSourceTranscript))
-            .withNativeFunction ("getModels", bindFn (&NativeFunctions::getModels))
-            .withNativeFunction ("getPlayHeadState", bindFn (&NativeFunctions::getPlayHeadState))
-            .withNativeFunction ("getProcessingTime", bindFn (&NativeFunctions::getProcessingTime))
-            .withNativeFunction ("getRegionSequences", bindFn (&NativeFunctions::getRegionSequences))
-            .withNativeFunction ("getTranscriptionStatus", bindFn (&NativeFunctions::getTranscriptionStatus))
-            .withNativeFunction ("getWhisperLanguages", bindFn (&NativeFunctions::getWhisperLanguages))
-            .withNativeFunction ("insertAudioAtCursor", bindFn (&NativeFunctions::insertAudioAtCursor))
-            .withNativeFunction ("play", bindFn (&NativeFunctions::play))
-            .withNativeFunction ("stop", bindFn (&NativeFunctions::stop))
-            .withNativeFunction ("saveFile", bindFn (&NativeFunctions::saveFile))
-            .withNativeFunction ("setAudioSourceTranscript", bindFn (&NativeFunctions::setAudioSourceTranscript))
-            .withNativeFunction ("setDebugMode", bindFn (&NativeFunctions::setDebugMode))
-            .withNativeFunction ("setPlaybackPosition", bindFn (&NativeFunctions::setPlaybackPosition))
-            .withNativeFunction ("setWebState", bindFn (&NativeFunctions::setWebState))
-            .withNativeFunction ("transcribeAudioSource", bindFn (&NativeFunctions::transcribeAudioSource));
+        auto options = initialOptions;
+
+        for (const auto& [name, memberFn] : bindings)
+            options = options.withNativeFunction (name, [this, memberFn] (const auto& args, auto&& complete)
+            {
+                (this->*memberFn) (args, std::forward<decltype (complete)> (complete));
+            });
+
+        return options;
     }
 
     void abortTranscription (const juce::var&, std::function<void (const juce::var&)> complete)
     {
         threadPool.removeAllJobs (true, 0); // Non-blocking call to initiate job removal
-        new AbortHandler (threadPool, complete, abortTimeout);
+        new AbortHandler (threadPool, std::move (complete), abortTimeout);
     }
 
     void canCreateMarkers (const juce::var&, std::function<void (const juce::var&)> complete)
     {
-        if (rpr.hasAddProjectMarker2)
+        if (rpr.has (ReaperProxy::Fn::AddProjectMarker2))
             complete (juce::var (true));
         else
             complete (juce::var (false));
@@ -86,11 +101,8 @@ public:
 
     void createMarkers (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 2 || ! args[0].isArray() || ! args[1].isString())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::array, Arg::string }, complete))
             return;
-        }
 
         const auto markers = args[0].getArray();
 
@@ -102,21 +114,23 @@ public:
         }
         const auto markerType = *markerTypeOpt;
 
-        if (! rpr.hasAddProjectMarker2)
+        if (! rpr.has (ReaperProxy::Fn::AddProjectMarker2))
         {
             complete (makeError ("Function not available"));
             return;
         }
 
-        withReaperUndo ("Create " + MarkerType::toString (markerType) + " from transcript", [&] {
+        const auto markerTypeName = MarkerType::toString (markerType);
+
+        withReaperUndo ("Create " + juce::String (markerTypeName.data(), markerTypeName.size()) + " from transcript", [&] {
             try
             {
                 if (markerType == MarkerType::notes)
-                    addReaperNotesTrack (markers);
+                    addReaperNotesTrack (unpackMarkers (*markers));
                 else if (markerType == MarkerType::takemarkers)
                     addReaperTakeMarkers (markers);
                 else
-                    addReaperMarkers (markers, markerType);
+                    addReaperMarkers (unpackMarkers (*markers), markerType);
             }
             catch (const ReaperProxy::Missing& e)
             {
@@ -153,23 +167,16 @@ public:
 
     void getAudioSourceTranscript (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 1 || ! args[0].isString())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::string }, complete))
             return;
-        }
 
         const auto audioSourceID = args[0].toString();
-        if (auto* document = getDocument())
+        if (auto* documentController = getDocumentController())
         {
-            const auto& audioSources = document->getAudioSources<ReaSpeechLiteAudioSource>();
-            for (const auto& audioSource : audioSources)
+            if (auto* audioSource = documentController->getAudioSourceByPersistentID (audioSourceID))
             {
-                if (audioSource->getPersistentID() == audioSourceID)
-                {
-                    complete (audioSource->getTranscript());
-                    return;
-                }
+                complete (audioSource->getTranscript());
+                return;
             }
             complete (makeError ("Audio source not found"));
             return;
@@ -179,15 +186,22 @@ public:
 
     void getModels (const juce::var&, std::function<void (const juce::var&)> complete)
     {
-        juce::Array<juce::var> models;
-        for (const auto& model : Config::models)
+        // Config::models never changes at runtime, so the var graph is built
+        // once and shared across calls (var is refcounted and never mutated
+        // by the WebView marshalling).
+        static const juce::var models = []
         {
-            juce::DynamicObject::Ptr modelObj = new juce::DynamicObject();
-            modelObj->setProperty ("name", juce::String(model.first));
-            modelObj->setProperty ("label", juce::String(model.second));
-            models.add (modelObj.get());
-        }
-        complete (juce::var (models));
+            juce::Array<juce::var> result;
+            for (const auto& model : Config::models)
+            {
+                juce::DynamicObject::Ptr modelObj = new juce::DynamicObject();
+                modelObj->setProperty ("name", juce::String(model.name.data(), model.name.size()));
+                modelObj->setProperty ("label", juce::String(model.label.data(), model.label.size()));
+                result.add (modelObj.get());
+            }
+            return juce::var (result);
+        }();
+        complete (models);
     }
 
     void getPlayHeadState (const juce::var&, std::function<void (const juce::var&)> complete)
@@ -200,14 +214,20 @@ public:
     {
         if (auto* document = getDocument())
         {
+            const auto& sequences = document->getRegionSequences();
+
             juce::Array<juce::var> regionSequences;
-            for (const auto& rs : document->getRegionSequences())
+            regionSequences.ensureStorageAllocated ((int) sequences.size());
+
+            for (const auto& rs : sequences)
             {
                 juce::DynamicObject::Ptr regionSequence = new juce::DynamicObject();
                 regionSequence->setProperty ("name", SafeUTF8::encode (rs->getName()));
                 regionSequence->setProperty ("orderIndex", rs->getOrderIndex());
 
                 juce::Array<juce::var> playbackRegions;
+                playbackRegions.ensureStorageAllocated ((int) rs->getPlaybackRegions().size());
+
                 for (const auto& pr : rs->getPlaybackRegions())
                 {
                     juce::DynamicObject::Ptr playbackRegion = new juce::DynamicObject();
@@ -233,45 +253,27 @@ public:
 
     void getTranscriptionStatus (const juce::var&, std::function<void (const juce::var&)> complete)
     {
-        juce::String status;
-        int progress = 0;
-        switch (asrStatus.load())
-        {
-            case ASRThreadPoolJobStatus::exporting:
-                status = "Exporting";
-                break;
-            case ASRThreadPoolJobStatus::downloadingModel:
-                status = "Downloading";
-                if (asrEngine != nullptr)
-                    progress = asrEngine->getProgress();
-                if (onnxEngine != nullptr)
-                    progress = onnxEngine->getProgress();
-                break;
-            case ASRThreadPoolJobStatus::loadingModel:
-                status = "Loading Model";
-                break;
-            case ASRThreadPoolJobStatus::transcribing:
-                status = "Transcribing";
-                if (asrEngine != nullptr)
-                    progress = asrEngine->getProgress();
-                if (onnxEngine != nullptr)
-                    progress = onnxEngine->getProgress();
-                break;
-            case ASRThreadPoolJobStatus::ready:
-            case ASRThreadPoolJobStatus::aborted:
-            case ASRThreadPoolJobStatus::finished:
-            case ASRThreadPoolJobStatus::failed:
-                break;
-        }
-        juce::DynamicObject::Ptr result = new juce::DynamicObject();
-        result->setProperty ("status", status);
-        result->setProperty ("progress", progress);
-        complete (juce::var (result.get()));
+        complete (makeTranscriptionStatus());
+    }
+
+    // Returns the transcription status, play head state and last processing
+    // time in a single reply, so the UI's periodic poll costs one JS<->native
+    // round trip instead of one per field.
+    void getStatusBundle (const juce::var&, std::function<void (const juce::var&)> complete)
+    {
+        juce::DynamicObject::Ptr bundle = new juce::DynamicObject();
+        bundle->setProperty ("transcription", makeTranscriptionStatus());
+        bundle->setProperty ("playHead", juce::var (audioProcessor.playHeadState.toDynamicObject().get()));
+        bundle->setProperty ("processingTime", lastProcessingTimeSeconds.load());
+        complete (juce::var (bundle.get()));
     }
 
     void getWhisperLanguages (const juce::var&, std::function<void (const juce::var&)> complete)
     {
-        complete (juce::var (WhisperLanguages::get()));
+        // WhisperLanguages::get() already caches the array; wrapping it in a
+        // var once avoids re-copying the element list on every call.
+        static const juce::var languages { WhisperLanguages::get() };
+        complete (languages);
     }
 
     void play (const juce::var&, std::function<void (const juce::var&)> complete)
@@ -298,11 +300,8 @@ public:
 
     void saveFile (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 4 || ! args[0].isString() || ! args[1].isString() || ! args[2].isString() || ! args[3].isString())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::string, Arg::string, Arg::string, Arg::string }, complete))
             return;
-        }
 
         const auto title = args[0].toString();
         const auto initialFilename = args[1].toString();
@@ -317,49 +316,55 @@ public:
             | juce::FileBrowserComponent::warnAboutOverwriting;
 
         fileChooser = std::make_unique<juce::FileChooser> (title, initialFile, patterns);
-        fileChooser->launchAsync (flags, [this, content, complete] (const juce::FileChooser& chooser)
+        fileChooser->launchAsync (flags, [content, complete = std::move (complete)] (const juce::FileChooser& chooser) mutable
         {
             const auto file = chooser.getResult();
-            if (file != juce::File())
+            if (file == juce::File())
+            {
+                juce::DynamicObject::Ptr result = new juce::DynamicObject();
+                result->setProperty ("filePath", "");
+                complete (juce::var (result.get()));
+                return;
+            }
+
+            // The chooser callback runs on the message thread, and writing an
+            // hour-long transcript's SRT/VTT is enough disk I/O to stall the
+            // UI - so the write happens on a detached thread and only the
+            // completion is posted back. (Not the ASR thread pool: abort
+            // removes its queued jobs, which would drop the reply.)
+            juce::Thread::launch ([file, content, complete = std::move (complete)]() mutable
             {
-                if (file.replaceWithText (content, false))
+                const bool ok = file.replaceWithText (content, false);
+                juce::MessageManager::callAsync ([file, ok, complete = std::move (complete)]
                 {
+                    if (! ok)
+                    {
+                        complete (makeError ("Failed to save file"));
+                        return;
+                    }
                     juce::DynamicObject::Ptr result = new juce::DynamicObject();
                     result->setProperty ("filePath", file.getFullPathName());
                     complete (juce::var (result.get()));
-                    return;
-                }
-                complete (makeError ("Failed to save file"));
-                return;
-            }
-            juce::DynamicObject::Ptr result = new juce::DynamicObject();
-            result->setProperty ("filePath", "");
-            complete (juce::var (result.get()));
+                });
+            });
         });
     }
 
     void setAudioSourceTranscript (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 2 || ! args[0].isString() || ! args[1].isObject())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::string, Arg::object }, complete))
             return;
-        }
 
         const auto audioSourceID = args[0].toString();
         const auto transcript = args[1].getDynamicObject();
 
-        if (auto* document = getDocument())
+        if (auto* documentController = getDocumentController())
         {
-            const auto& audioSources = document->getAudioSources<ReaSpeechLiteAudioSource>();
-            for (const auto& audioSource : audioSources)
+            if (auto* audioSource = documentController->getAudioSourceByPersistentID (audioSourceID))
             {
-                if (audioSource->getPersistentID() == audioSourceID)
-                {
-                    audioSource->setTranscript (transcript);
-                    complete (juce::var());
-                    return;
-                }
+                audioSource->setTranscript (transcript);
+                complete (juce::var());
+                return;
             }
             complete (makeError ("Audio source not found"));
             return;
@@ -369,11 +374,8 @@ public:
 
     void setPlaybackPosition (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 1)
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::any }, complete))
             return;
-        }
 
         if (auto* playbackController = getPlaybackController())
         {
@@ -387,11 +389,8 @@ public:
 
     void setWebState (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 1 || ! args[0].isString())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::string }, complete))
             return;
-        }
 
         audioProcessor.state.setProperty ("webState", args[0], nullptr);
         complete (juce::var());
@@ -399,11 +398,8 @@ public:
 
     void transcribeAudioSource (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (! args.isArray() || args.size() < 1)
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::any }, complete))
             return;
-        }
 
         if (asrEngine == nullptr)
         {
@@ -417,12 +413,18 @@ public:
             const auto optionsObj = args[1].getDynamicObject();
             if (optionsObj != nullptr)
             {
-                if (optionsObj->hasProperty ("modelName"))
-                    options->modelName = optionsObj->getProperty ("modelName");
-                if (optionsObj->hasProperty ("language"))
-                    options->language = optionsObj->getProperty ("language");
-                if (optionsObj->hasProperty ("translate"))
-                    options->translate = optionsObj->getProperty ("translate");
+                // One pass over the property set instead of paired
+                // hasProperty/getProperty calls, each of which walks the
+                // NamedValueSet linearly.
+                for (const auto& prop : optionsObj->getProperties())
+                {
+                    if (prop.name == modelNameId)
+                        options->modelName = prop.value;
+                    else if (prop.name == languageId)
+                        options->language = prop.value;
+                    else if (prop.name == translateId)
+                        options->translate = prop.value;
+                }
             }
         }
 
@@ -434,21 +436,28 @@ public:
 
             juce::ThreadPoolJob* job = nullptr;
 
-            auto statusCallback = [this] (ASRThreadPoolJobStatus status) {
-                asrStatus = status;
+            // The job callbacks only touch this through a WeakReference, so a
+            // job that outlives the editor updates nothing instead of
+            // dereferencing a destroyed NativeFunctions.
+            auto statusCallback = [weakThis = juce::WeakReference<NativeFunctions> (this)] (ASRThreadPoolJobStatus status) {
+                if (auto* self = weakThis.get())
+                    self->asrStatus.store (status, std::memory_order_relaxed);
             };
 
-            auto completionCallback = [this, complete] (const ASRThreadPoolJobResult& result) {
-                // When the last job completes, calculate total wall-clock time
-                int remainingJobs = activeJobCount.fetch_sub(1) - 1;
-                if (remainingJobs == 0)
+            auto completionCallback = [weakThis = juce::WeakReference<NativeFunctions> (this), complete = std::move (complete)] (const ASRThreadPoolJobResult& result) {
+                if (auto* self = weakThis.get())
                 {
-                    auto endTime = juce::Time::currentTimeMillis();
-                    auto startTime = batchStartTime.load();
-                    if (startTime > 0)
+                    // When the last job completes, calculate total wall-clock time
+                    int remainingJobs = self->activeJobCount.fetch_sub(1) - 1;
+                    if (remainingJobs == 0)
                     {
-                        double elapsedSeconds = (endTime - startTime) / 1000.0;
-                        lastProcessingTimeSeconds.store(elapsedSeconds);
+                        auto endTime = juce::Time::currentTimeMillis();
+                        auto startTime = self->batchStartTime.load();
+                        if (startTime > 0)
+                        {
+                            double elapsedSeconds = (endTime - startTime) / 1000.0;
+                            self->lastProcessingTimeSeconds.store(elapsedSeconds);
+                        }
                     }
                 }
 
@@ -472,45 +481,23 @@ public:
                 juce::String audioSourceName = SafeUTF8::encode (audioSource->getName());
                 juce::String audioFilePath;
 
-                if (rpr.hasCountMediaItems && rpr.hasGetMediaItem && rpr.hasGetActiveTake &&
-                    rpr.hasGetMediaItemTake_Source && rpr.hasGetMediaSourceFileName)
-                {
-                    int numItems = rpr.CountMediaItems (ReaperProxy::activeProject);
-                    for (int i = 0; i < numItems; ++i)
-                    {
-                        auto* item = rpr.GetMediaItem (ReaperProxy::activeProject, i);
-                        auto* take = rpr.GetActiveTake (item);
-                        if (take != nullptr)
-                        {
-                            auto* source = rpr.GetMediaItemTake_Source (take);
-                            if (source != nullptr)
-                            {
-                                char filenamebuf[4096];
-                                rpr.GetMediaSourceFileName (source, filenamebuf, sizeof(filenamebuf));
-                                juce::String filename (filenamebuf);
-                                juce::String filenameWithoutExt = juce::File(filename).getFileNameWithoutExtension();
-                                juce::String audioSourceNameWithoutExt = audioSourceName.upToLastOccurrenceOf(".", false, false);
-
-                                if (filename.isNotEmpty() && filenameWithoutExt == audioSourceNameWithoutExt)
-                                {
-                                    audioFilePath = filename;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
+                const auto& index = buildFilenameIndex();
+                const auto stem = audioSourceName.upToLastOccurrenceOf (".", false, false).toStdString();
+
+                if (const auto it = index.find (stem); it != index.end())
+                    audioFilePath = it->second;
 
                 rsAudioSource->setFilePath (audioFilePath);
             }
 
             // Logger callback that outputs to REAPER console
-            auto loggerCallback = [this] (const juce::String& message) {
-                if (rpr.hasShowConsoleMsg)
+            auto loggerCallback = [weakThis = juce::WeakReference<NativeFunctions> (this)] (const juce::String& message) {
+                auto* self = weakThis.get();
+                if (self != nullptr && self->rpr.has (ReaperProxy::Fn::ShowConsoleMsg))
                 {
                     try
                     {
-                        rpr.ShowConsoleMsg ((message + "\n").toRawUTF8());
+                        self->rpr.ShowConsoleMsg ((message + "\n").toRawUTF8());
                     }
                     catch (...) {}
                 }
@@ -552,11 +539,8 @@ public:
 
     void insertAudioAtCursor (const juce::var& args, std::function<void (const juce::var&)> complete)
     {
-        if (!args.isArray() || args.size() < 3 || !args[2].isString())
-        {
-            complete (makeError ("Invalid arguments"));
+        if (! validateArgs (args, { Arg::any, Arg::any, Arg::string }, complete))
             return;
-        }
 
         const double startTime = args[0];
         const double endTime = args[1];
@@ -577,14 +561,14 @@ public:
         }
 
         ReaperProxy::MediaTrack* track = nullptr;
-        if (rpr.hasCountSelectedTracks && rpr.hasGetSelectedTrack)
+        if (rpr.has (ReaperProxy::Fn::CountSelectedTracks) && rpr.has (ReaperProxy::Fn::GetSelectedTrack))
         {
             int numSelectedTracks = rpr.CountSelectedTracks (ReaperProxy::activeProject);
             if (numSelectedTracks > 0)
                 track = rpr.GetSelectedTrack (ReaperProxy::activeProject, 0);
         }
 
-        if (track == nullptr && rpr.hasGetLastTouchedTrack)
+        if (track == nullptr && rpr.has (ReaperProxy::Fn::GetLastTouchedTrack))
             track = rpr.GetLastTouchedTrack();
 
         if (track == nullptr)
@@ -606,7 +590,7 @@ public:
                 auto* pcmSource = rpr.PCM_Source_CreateFromFile (audioFilePath.toRawUTF8());
                 rpr.SetMediaItemTake_Source (take, pcmSource);
 
-                if (rpr.hasSetMediaItemTakeInfo_Value)
+                if (rpr.has (ReaperProxy::Fn::SetMediaItemTakeInfo_Value))
                     rpr.SetMediaItemTakeInfo_Value (take, "D_STARTOFFS", startTime);
             }
             catch (const ReaperProxy::Missing& e)
@@ -637,9 +621,9 @@ public:
             debugValue = static_cast<bool>(args);
         }
 
-        debugMode.store (debugValue);
+        debugMode.store (debugValue, std::memory_order_relaxed);
 
-        if (rpr.hasShowConsoleMsg)
+        if (rpr.has (ReaperProxy::Fn::ShowConsoleMsg))
         {
             juce::String msg = "ReaSpeech: Debug mode set to " + juce::String(debugValue ? "ON" : "OFF") + "\n";
             rpr.ShowConsoleMsg (msg.toRawUTF8());
@@ -675,40 +659,213 @@ private:
 
     juce::ARAAudioSource* getAudioSourceByPersistentID (const juce::String& audioSourcePersistentID)
     {
-        if (auto* document = getDocument())
+        if (auto* documentController = getDocumentController())
+            return documentController->getAudioSourceByPersistentID (audioSourcePersistentID);
+        return nullptr;
+    }
+
+    // Builds a basename-without-extension -> full-path index with a single
+    // pass over the project's media items, so callers can resolve any number
+    // of audio source names without rescanning the item list per source.
+    // The index is cached across calls keyed by REAPER's project state change
+    // counter, which ticks on any undoable project edit - so repeat
+    // transcribes in an unchanged project cost one counter read instead of a
+    // full item walk.
+    const std::unordered_map<std::string, juce::String>& buildFilenameIndex()
+    {
+        if (rpr.has (ReaperProxy::Fn::GetProjectStateChangeCount))
+        {
+            const int stateCount = rpr.GetProjectStateChangeCount (ReaperProxy::activeProject);
+            if (filenameIndexValid && stateCount == filenameIndexStateCount)
+                return filenameIndex;
+            filenameIndexStateCount = stateCount;
+            filenameIndexValid = true;
+        }
+        else
+        {
+            // Without the counter there is no safe invalidation signal, so
+            // the index is rebuilt on every call as before.
+            filenameIndexValid = false;
+        }
+
+        auto& byBasename = filenameIndex;
+        byBasename.clear();
+
+        if (! (rpr.has (ReaperProxy::Fn::CountMediaItems) && rpr.has (ReaperProxy::Fn::GetMediaItem) && rpr.has (ReaperProxy::Fn::GetActiveTake) &&
+               rpr.has (ReaperProxy::Fn::GetMediaItemTake_Source) && rpr.has (ReaperProxy::Fn::GetMediaSourceFileName)))
+            return byBasename;
+
+        const int numItems = rpr.CountMediaItems (ReaperProxy::activeProject);
+        byBasename.reserve ((size_t) numItems);
+
+        for (int i = 0; i < numItems; ++i)
         {
-            for (const auto& as : document->getAudioSources())
-                if (as->getPersistentID() == audioSourcePersistentID)
-                    return as;
+            auto* item = rpr.GetMediaItem (ReaperProxy::activeProject, i);
+            auto* take = rpr.GetActiveTake (item);
+            if (take == nullptr)
+                continue;
+
+            auto* source = rpr.GetMediaItemTake_Source (take);
+            if (source == nullptr)
+                continue;
 
+            char filenamebuf[4096];
+            rpr.GetMediaSourceFileName (source, filenamebuf, sizeof (filenamebuf));
+
+            const std::string_view path (filenamebuf);
+            if (path.empty())
+                continue;
+
+            // REAPER hands back raw UTF-8, and '/', '\\' and '.' can never
+            // occur inside a multi-byte sequence, so the basename and stem
+            // split byte-wise without decoding to UTF-16 per item.
+            const auto basename = path.substr (path.find_last_of ("/\\") + 1);
+            const auto dot = basename.rfind ('.');
+            const auto stem = dot == std::string_view::npos ? basename : basename.substr (0, dot);
+
+            // First item wins on duplicate basenames, matching the order the
+            // per-source scan used to find them.
+            byBasename.emplace (std::string (stem), juce::String::fromUTF8 (path.data(), (int) path.size()));
         }
-        return nullptr;
+
+        return byBasename;
     }
 
-    juce::var makeError (const juce::String& message)
+    juce::var makeTranscriptionStatus()
+    {
+        juce::String status;
+        int progress = 0;
+        // Relaxed is enough: the status is a standalone flag and the reply
+        // orders nothing against other memory.
+        switch (asrStatus.load (std::memory_order_relaxed))
+        {
+            case ASRThreadPoolJobStatus::exporting:
+                status = "Exporting";
+                break;
+            case ASRThreadPoolJobStatus::downloadingModel:
+                status = "Downloading";
+                if (asrEngine != nullptr)
+                    progress = asrEngine->getProgress();
+                if (onnxEngine != nullptr)
+                    progress = onnxEngine->getProgress();
+                break;
+            case ASRThreadPoolJobStatus::loadingModel:
+                status = "Loading Model";
+                break;
+            case ASRThreadPoolJobStatus::transcribing:
+                status = "Transcribing";
+                if (asrEngine != nullptr)
+                    progress = asrEngine->getProgress();
+                if (onnxEngine != nullptr)
+                    progress = onnxEngine->getProgress();
+                break;
+            case ASRThreadPoolJobStatus::ready:
+            case ASRThreadPoolJobStatus::aborted:
+            case ASRThreadPoolJobStatus::finished:
+            case ASRThreadPoolJobStatus::failed:
+                break;
+        }
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty ("status", status);
+        result->setProperty ("progress", progress);
+        return juce::var (result.get());
+    }
+
+    enum class Arg { string, object, array, number, any };
+
+    // Shared argument-shape check: verifies args is an array holding at
+    // least the listed elements, each of the expected kind. On mismatch it
+    // completes with a cached "Invalid arguments" error - one var shared by
+    // every rejection instead of a fresh DynamicObject each time.
+    static bool validateArgs (const juce::var& args, std::initializer_list<Arg> kinds,
+                              const std::function<void (const juce::var&)>& complete)
+    {
+        const auto fail = [&complete]
+        {
+            static const juce::var invalidArgs = makeError ("Invalid arguments");
+            complete (invalidArgs);
+            return false;
+        };
+
+        if (! args.isArray() || args.size() < (int) kinds.size())
+            return fail();
+
+        int i = 0;
+        for (const auto kind : kinds)
+        {
+            const auto& value = args[i++];
+            switch (kind)
+            {
+                case Arg::string: if (! value.isString()) return fail(); break;
+                case Arg::object: if (! value.isObject()) return fail(); break;
+                case Arg::array:  if (! value.isArray())  return fail(); break;
+                case Arg::number: if (! (value.isInt() || value.isInt64() || value.isDouble())) return fail(); break;
+                case Arg::any: break;
+            }
+        }
+
+        return true;
+    }
+
+    static juce::var makeError (const juce::String& message)
     {
         juce::DynamicObject::Ptr error = new juce::DynamicObject();
         error->setProperty ("error", message);
         return juce::var (error.get());
     }
 
-    void addReaperMarkers (const juce::Array<juce::var>* markers, const MarkerType::Enum markerType)
+    // Marker property names, interned once instead of re-hashing the string
+    // literals into Identifiers on every loop iteration.
+    inline static const juce::Identifier startId { "start" };
+    inline static const juce::Identifier endId { "end" };
+    inline static const juce::Identifier nameId { "name" };
+    inline static const juce::Identifier sourceIDId { "sourceID" };
+
+    // Transcription option property names, interned likewise.
+    inline static const juce::Identifier modelNameId { "modelName" };
+    inline static const juce::Identifier languageId { "language" };
+    inline static const juce::Identifier translateId { "translate" };
+
+    // Plain per-marker data, unpacked once at the boundary so the REAPER
+    // loops iterate contiguous doubles and Strings instead of re-querying
+    // refcounted var properties per field.
+    struct Marker
     {
-        int markerNum = 1;
-        for (const auto& markerVar : *markers)
+        double start;
+        double end;
+        juce::String name;
+    };
+
+    static std::vector<Marker> unpackMarkers (const juce::Array<juce::var>& markers)
+    {
+        std::vector<Marker> result;
+        result.reserve ((size_t) markers.size());
+
+        for (const auto& markerVar : markers)
         {
             const auto marker = markerVar.getDynamicObject();
-            const auto regions = markerType == MarkerType::regions;
-            const auto start = marker->getProperty ("start");
-            const auto end = marker->getProperty ("end");
-            const auto name = marker->getProperty ("name");
+            result.push_back ({ marker->getProperty (startId),
+                                marker->getProperty (endId),
+                                marker->getProperty (nameId).toString() });
+        }
+
+        return result;
+    }
+
+    void addReaperMarkers (const std::vector<Marker>& markers, const MarkerType::Enum markerType)
+    {
+        // Loop invariants hoisted: the region flag only depends on the marker
+        // type, not on the marker being inserted.
+        const bool regions = markerType == MarkerType::regions;
 
-            rpr.AddProjectMarker2 (ReaperProxy::activeProject, regions, start, end, name.toString().toRawUTF8(), markerNum, 0);
-            markerNum++;
+        for (size_t i = 0; i < markers.size(); ++i)
+        {
+            const auto& marker = markers[i];
+            rpr.AddProjectMarker2 (ReaperProxy::activeProject, regions, marker.start, marker.end, marker.name.toRawUTF8(), (int) i + 1, 0);
         }
     }
 
-    void addReaperNotesTrack (const juce::Array<juce::var>* markers, const char* trackName = "Transcript")
+    void addReaperNotesTrack (const std::vector<Marker>& markers, const char* trackName = "Transcript")
     {
         const auto index = 0;
         const auto originalPosition = rpr.GetCursorPositionEx (ReaperProxy::activeProject);
@@ -718,38 +875,73 @@ private:
         rpr.SetOnlyTrackSelected (track);
         rpr.GetSetMediaTrackInfo_String (track, "P_NAME", const_cast<char*> (trackName), true);
 
-        for (const auto& markerVar : *markers)
-        {
-            const auto marker = markerVar.getDynamicObject();
-            const auto start = marker->getProperty ("start");
-            const auto end = marker->getProperty ("end");
-            const auto name = marker->getProperty ("name");
+        // Clearing the item selection is an O(project items) sweep, so it
+        // runs once before the loop rather than once per marker - the insert
+        // action leaves each new item as the only selected one.
+        rpr.SelectAllMediaItems (ReaperProxy::activeProject, false);
 
-            const auto item = createEmptyReaperItem (start, end);
-            setReaperNoteText (item, name.toString());
+        for (const auto& marker : markers)
+        {
+            const auto item = createEmptyReaperItem (marker.start, marker.end);
+            setReaperNoteText (item, marker.name);
         }
 
+        rpr.SelectAllMediaItems (ReaperProxy::activeProject, false);
         rpr.SetEditCurPos2 (ReaperProxy::activeProject, originalPosition, true, true);
     }
 
     void addReaperTakeMarkers (const juce::Array<juce::var>* markers)
     {
-        debugLog ("Starting take markers creation for " + juce::String(markers->size()) + " markers");
+        debugLog ([&] { return "Starting take markers creation for " + juce::String(markers->size()) + " markers"; });
+
+        // Walk the media items once up front, caching each active take with
+        // its source filename. The marker loop below then matches against
+        // this in-memory list, so M markers cost O(N + M) REAPER API
+        // crossings instead of the former O(M x N) per-marker rescans.
+        struct ItemTake
+        {
+            ReaperProxy::MediaTake* take;
+            juce::String filename;
+        };
+
+        const int numItems = rpr.CountMediaItems (ReaperProxy::activeProject);
+
+        debugLog ([&] { return "Found " + juce::String(numItems) + " total media items in project"; });
+
+        std::vector<ItemTake> itemTakes;
+        itemTakes.reserve ((size_t) numItems);
 
-        // Get all media items in the project
-        int numItems = rpr.CountMediaItems (ReaperProxy::activeProject);
+        for (int i = 0; i < numItems; ++i)
+        {
+            auto* item = rpr.GetMediaItem (ReaperProxy::activeProject, i);
+
+            auto* take = rpr.GetActiveTake (item);
+            if (take == nullptr)
+                continue;
 
-        debugLog ("Found " + juce::String(numItems) + " total media items in project");
+            auto* source = rpr.GetMediaItemTake_Source (take);
+            if (source == nullptr)
+                continue;
+
+            char filenamebuf[4096];
+            rpr.GetMediaSourceFileName (source, filenamebuf, sizeof(filenamebuf));
+            itemTakes.push_back ({ take, juce::String (filenamebuf) });
+        }
+
+        // Markers from one transcript share a sourceID, so the substring
+        // matches are computed once per distinct ID and reused for every
+        // marker carrying it.
+        std::unordered_map<std::string, std::vector<ReaperProxy::MediaTake*>> takesBySourceID;
 
         for (const auto& markerVar : *markers)
         {
             const auto marker = markerVar.getDynamicObject();
-            double sourcePos = marker->getProperty ("start");
-            const auto name = marker->getProperty ("name");
-            const auto sourceID = marker->getProperty ("sourceID").toString();
+            double sourcePos = marker->getProperty (startId);
+            const auto name = marker->getProperty (nameId);
+            const auto sourceID = marker->getProperty (sourceIDId).toString();
             int matchesFound = 0;
 
-            debugLog ("Processing marker: '" + name.toString() + "' at " + juce::String(sourcePos) + "s for sourceID: " + sourceID);
+            debugLog ([&] { return "Processing marker: '" + name.toString() + "' at " + juce::String(sourcePos) + "s for sourceID: " + sourceID; });
 
             // Skip if sourceID is empty to avoid matching all files
             if (sourceID.isEmpty())
@@ -758,105 +950,212 @@ private:
                 continue;
             }
 
-            // Find all media items with the matching audio source (across all tracks)
-            for (int i = 0; i < numItems; ++i)
-            {
-                auto* item = rpr.GetMediaItem (ReaperProxy::activeProject, i);
-
-                // Get the active take from the item
-                auto* take = rpr.GetActiveTake (item);
-                if (take == nullptr)
-                    continue;
-
-                // Get the take's source
-                auto* source = rpr.GetMediaItemTake_Source (take);
-                if (source == nullptr)
-                    continue;
+            // Find all takes with the matching audio source (across all tracks)
+            const auto [matches, inserted] = takesBySourceID.try_emplace (sourceID.toStdString());
+            if (inserted)
+                for (const auto& entry : itemTakes)
+                    if (entry.filename.contains (sourceID))
+                        matches->second.push_back (entry.take);
 
-                // Get the source filename
-                char filenamebuf[4096];
-                rpr.GetMediaSourceFileName (source, filenamebuf, sizeof(filenamebuf));
-                juce::String filename (filenamebuf);
-
-                // Match by audio source ID (contained in filename)
-                if (filename.contains (sourceID))
+            for (auto* take : matches->second)
+            {
+                // Add take marker: idx -1 means insert new marker
+                int result = rpr.SetTakeMarker (take, -1, name.toString().toRawUTF8(), &sourcePos, nullptr);
+                if (result >= 0)
                 {
-                    // Add take marker: idx -1 means insert new marker
-                    int result = rpr.SetTakeMarker (take, -1, name.toString().toRawUTF8(), &sourcePos, nullptr);
-                    if (result >= 0)
-                    {
-                        matchesFound++;
-                        debugLog ("  Added take marker '" + name.toString() + "' to item " + juce::String(i) + " at " + juce::String(sourcePos) + "s");
-                    }
-                    else
-                    {
-                        debugLog ("  Failed to add take marker to item " + juce::String(i));
-                    }
-                    // Continue checking other items - don't break!
+                    matchesFound++;
+                    debugLog ([&] { return "  Added take marker '" + name.toString() + "' at " + juce::String(sourcePos) + "s"; });
+                }
+                else
+                {
+                    debugLog ("  Failed to add take marker");
                 }
             }
 
-            debugLog ("  Total matches for marker '" + name.toString() + "': " + juce::String(matchesFound));
+            debugLog ([&] { return "  Total matches for marker '" + name.toString() + "': " + juce::String(matchesFound); });
         }
 
         debugLog ("Finished creating take markers");
     }
 
+    // Counts '%' bytes eight at a time using the SWAR zero-byte trick on the
+    // xor-masked word; memcpy keeps the loads well-defined for any alignment.
+    static size_t countPercentBytes (const char* data, size_t length) noexcept
+    {
+        constexpr std::uint64_t ones = 0x0101010101010101ULL;
+        constexpr std::uint64_t highBits = 0x8080808080808080ULL;
+        constexpr std::uint64_t percents = 0x2525252525252525ULL; // '%' in every byte
+
+        size_t count = 0;
+        size_t i = 0;
+
+        for (; i + sizeof (std::uint64_t) <= length; i += sizeof (std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy (&word, data + i, sizeof (word));
+
+            const auto masked = word ^ percents;
+            if (((masked - ones) & ~masked & highBits) != 0)
+                for (size_t j = i; j < i + sizeof (std::uint64_t); ++j)
+                    count += data[j] == '%' ? 1u : 0u;
+        }
+
+        for (; i < length; ++i)
+            count += data[i] == '%' ? 1u : 0u;
+
+        return count;
+    }
+
+    // Callers must clear the item selection before the first call; the
+    // insert action then leaves each new item as the only selected one, so
+    // no per-call selection sweep is needed.
     ReaperProxy::MediaItem* createEmptyReaperItem (const double start, const double end)
     {
         rpr.Main_OnCommandEx(40142, 0, ReaperProxy::activeProject); // Insert empty item
         auto* item = rpr.GetSelectedMediaItem(ReaperProxy::activeProject, 0);
-        rpr.SelectAllMediaItems (ReaperProxy::activeProject, false);
         rpr.SetMediaItemPosition (item, start, true);
         rpr.SetMediaItemLength (item, end - start, true);
         return item;
     }
 
-    void setReaperNoteText (ReaperProxy::MediaItem* item, const juce::String& text, bool stretch = false)
+    // The stretch flag is a template parameter so the flags line and its
+    // share of the reservation constant-fold away in the common (and
+    // currently only) non-stretch instantiation.
+    template <bool stretch = false>
+    void setReaperNoteText (ReaperProxy::MediaItem* item, const juce::String& text)
     {
-        char buffer[4096];
-        rpr.GetItemStateChunk (item, buffer, sizeof (buffer), false);
-        const auto chunk = juce::String (buffer);
+        // The chunk buffer persists across calls so tight marker loops reuse
+        // one allocation instead of zeroing a fresh stack array each time.
+        // This function is currently only used with new items, whose chunks
+        // are around 200 bytes; the initial size leaves ample headroom.
+        thread_local std::vector<char> buffer (4096);
+
+        // GetItemStateChunk reports no length, so a chunk that fills the
+        // buffer to its last byte means truncation - splicing into a cut-off
+        // chunk would corrupt the item on SetItemStateChunk. Grow and re-read
+        // until the chunk fits (bounded to keep a misbehaving host finite).
+        constexpr size_t maxChunkSize = 1 << 20;
+        size_t chunkSize = 0;
+
+        for (;;)
+        {
+            rpr.GetItemStateChunk (item, buffer.data(), (int) buffer.size(), false);
+            chunkSize = strnlen (buffer.data(), buffer.size());
 
-        // This function is currently only used with new items, and the chunk size
-        // in that case is currently around 200 bytes. If this changes, the buffer
-        // size may need to be increased. The current size is a bit arbitrary.
-        auto chunkSize = static_cast<size_t> (chunk.length());
-        auto bufferSize = sizeof (buffer);
-        jassert (chunkSize < bufferSize - 1);
+            if (chunkSize < buffer.size() - 1)
+                break;
 
-        juce::String notesChunk;
-        notesChunk << "<NOTES\n|" << text.trim() << "\n>\n";
-        const juce::String flagsChunk { stretch ? "IMGRESOURCEFLAGS 11\n" : "" };
+            if (buffer.size() >= maxChunkSize)
+            {
+                jassertfalse; // Item chunk over 1 MB - refusing to touch it
+                return;
+            }
 
-        const auto newChunk = chunk.replace(">", notesChunk.replace ("%", "%%") + flagsChunk + ">");
-        rpr.SetItemStateChunk (item, newChunk.toRawUTF8(), false);
+            buffer.resize (buffer.size() * 2);
+        }
+
+        // A freshly created empty item's chunk contains a single closing '>'.
+        // The notes block is spliced in front of it in one pass over the raw
+        // bytes, escaping '%' while streaming the text, instead of building
+        // intermediate Strings and replace() copies of the whole chunk.
+        const std::string_view chunk (buffer.data(), chunkSize);
+        const auto closing = chunk.rfind ('>');
+        jassert (closing != std::string_view::npos);
+        if (closing == std::string_view::npos)
+            return;
+
+        const auto trimmed = text.trim();
+        const auto* trimmedText = trimmed.toRawUTF8();
+        const auto trimmedLength = strlen (trimmedText);
+
+        const auto percentCount = countPercentBytes (trimmedText, trimmedLength);
+
+        // Exact final length, so the builder allocates once: the original
+        // chunk, the notes block framing, the text plus one byte per escaped
+        // '%', and the optional flags line.
+        constexpr size_t notesFraming = 8 + 3;  // "<NOTES\n|" and "\n>\n"
+        constexpr size_t flagsLength = 20;      // "IMGRESOURCEFLAGS 11\n"
+
+        std::string newChunk;
+        newChunk.reserve (chunkSize + notesFraming + trimmedLength + percentCount + (stretch ? flagsLength : 0));
+
+        newChunk.append (chunk.substr (0, closing));
+        newChunk += "<NOTES\n|";
+
+        if (percentCount == 0)
+        {
+            // Typical transcript text has no '%' - append it wholesale.
+            newChunk.append (trimmedText, trimmedLength);
+        }
+        else
+        {
+            for (size_t i = 0; i < trimmedLength; ++i)
+            {
+                const char c = trimmedText[i];
+                newChunk += c;
+                if (c == '%') // '%' is an escape lead-in in REAPER state chunks
+                    newChunk += '%';
+            }
+        }
+
+        newChunk += "\n>\n";
+
+        if constexpr (stretch)
+            newChunk += "IMGRESOURCEFLAGS 11\n";
+
+        newChunk.append (chunk.substr (closing));
+
+        rpr.SetItemStateChunk (item, newChunk.c_str(), false);
     }
 
-    void withReaperUndo (const juce::String& label, std::function<void()> action)
+    // Templated on the action so the callable is invoked directly (and can
+    // inline) instead of going through a std::function type erasure.
+    template <typename Action>
+    void withReaperUndo (const juce::String& label, Action&& action)
     {
-        if (rpr.hasPreventUIRefresh)
-            rpr.PreventUIRefresh(1);
+        // Scopes are depth-counted: nested calls fold into the outermost one,
+        // so a composite action costs REAPER a single undo point and project
+        // state snapshot instead of one per sub-action. Only the outermost
+        // label names the undo point.
+        if (++reaperUndoDepth == 1)
+        {
+            if (rpr.has (ReaperProxy::Fn::PreventUIRefresh))
+                rpr.PreventUIRefresh(1);
 
-        if (rpr.hasUndo_BeginBlock2)
-            rpr.Undo_BeginBlock2(ReaperProxy::activeProject);
+            if (rpr.has (ReaperProxy::Fn::Undo_BeginBlock2))
+                rpr.Undo_BeginBlock2(ReaperProxy::activeProject);
+        }
 
         action();
 
-        if (rpr.hasUndo_EndBlock2)
-            rpr.Undo_EndBlock2(ReaperProxy::activeProject, label.toRawUTF8(), -1);
+        if (--reaperUndoDepth == 0)
+        {
+            if (rpr.has (ReaperProxy::Fn::Undo_EndBlock2))
+                rpr.Undo_EndBlock2(ReaperProxy::activeProject, label.toRawUTF8(), -1);
 
-        if (rpr.hasPreventUIRefresh)
-            rpr.PreventUIRefresh(-1);
+            if (rpr.has (ReaperProxy::Fn::PreventUIRefresh))
+                rpr.PreventUIRefresh(-1);
+        }
     }
 
     // Helper to output debug messages to ReaScript console when debug mode is on
     // This replaces DBG() which only works in Debug builds and goes to system debugger
-    void debugLog (const juce::String& message)
+    void debugLog (const char* message)
     {
-        if (debugMode.load() && rpr.hasShowConsoleMsg)
+        if (debugMode.load (std::memory_order_relaxed) && rpr.has (ReaperProxy::Fn::ShowConsoleMsg))
         {
-            rpr.ShowConsoleMsg ((message + "\n").toRawUTF8());
+            rpr.ShowConsoleMsg ((juce::String (message) + "\n").toRawUTF8());
+        }
+    }
+
+    // Overload taking a callable that builds the message, so call sites pay
+    // for string concatenation only when debug mode is actually on.
+    template <typename MessageBuilder>
+    void debugLog (MessageBuilder&& buildMessage)
+    {
+        if (debugMode.load (std::memory_order_relaxed) && rpr.has (ReaperProxy::Fn::ShowConsoleMsg))
+        {
+            rpr.ShowConsoleMsg ((buildMessage() + "\n").toRawUTF8());
         }
     }
 
@@ -871,7 +1170,17 @@ private:
     std::atomic<double> lastProcessingTimeSeconds { 0.0 };
     std::atomic<int> activeJobCount { 0 };
     std::atomic<juce::int64> batchStartTime { 0 };
+    int reaperUndoDepth = 0;
+
+    // Media item filename index, cached across transcribe calls and keyed by
+    // REAPER's project state change counter (see buildFilenameIndex).
+    std::unordered_map<std::string, juce::String> filenameIndex;
+    int filenameIndexStateCount = 0;
+    bool filenameIndexValid = false;
+
     juce::ThreadPool threadPool { 1 };
 
     std::unique_ptr<juce::FileChooser> fileChooser;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (NativeFunctions)
 };
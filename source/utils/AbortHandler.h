@@ -10,7 +10,7 @@ class AbortHandler : public juce::Timer
 public:
     AbortHandler (juce::ThreadPool& pool, std::function<void (const juce::var&)> callback, int timeoutMs) :
         threadPool (pool),
-        complete (callback),
+        complete (std::move (callback)),
         startTime (juce::Time::getMillisecondCounter()),
         timeout (static_cast<juce::uint32> (timeoutMs))
     {
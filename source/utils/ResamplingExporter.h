@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -48,105 +49,233 @@ struct ResamplingExporter
             DBG (msg);  // Also log to debug console
         };
 
+        // Calculate destination buffer size
+        const double speedRatio = sourceSampleRate / destSampleRate; // Source samples per dest sample
+        const auto destSampleCount = juce::roundToInt (sourceSampleCount * destSampleRate / sourceSampleRate);
+        buffer.resize (static_cast<size_t>(destSampleCount));
+
+        bool gotAudio = false;
+
+        // Resolve the direct-read fallback file up front, so a host already
+        // known to exhibit the ARA silence bug can skip the doomed full-file
+        // ARA read (and its allocation) outright.
+        juce::String filePath;
+        if (auto* rsAudioSource = dynamic_cast<ReaSpeechLiteAudioSource*>(audioSource))
+            filePath = rsAudioSource->getFilePath();
+
+        const juce::File audioFile (filePath);
+        const bool fileAvailable = filePath.isNotEmpty() && audioFile.existsAsFile();
+
+        const bool skipARA = araKnownBroken.load (std::memory_order_relaxed) && fileAvailable;
+        if (skipARA)
+            log ("ResamplingExporter: Skipping ARA read (known to return silence), using direct file access");
+
         // WORKAROUND FOR REAPER ARA BUG:
         // ARAAudioSourceReader::read() returns silence for successive reads after the first one.
         // This appears to be a REAPER ARA implementation bug.
-        // Solution: Read all source audio into memory first, then resample manually.
+        // Because only the first read works, the ARA path cannot stream: the
+        // whole source has to be fetched in a single read, which forces the
+        // full-file buffer below (~1.3GB for a 1-hour stereo file at
+        // 44.1kHz). It is scoped so it is released before the direct-file
+        // fallback runs, which streams block by block instead.
 
-        // NOTE: This loads entire audio file into memory before resampling.
-        // Memory usage: ~1.3GB for 1-hour stereo file at 44.1kHz
-        // Files are processed sequentially, so only one file is in memory at a time.
-        juce::AudioBuffer<float> sourceBuffer (sourceChannelCount, static_cast<int>(sourceSampleCount));
-        sourceBuffer.clear();
+        // Resolved early when the ARA probe reads silent, so the fallback is
+        // known to be viable before the ARA data is discarded; the streaming
+        // pass below then reuses it.
+        std::unique_ptr<juce::AudioFormatReader> fileReader;
 
-        // Try ARA read first (REAPER ARA bug workaround - may return silence)
-        bool gotAudio = false;
+        if (! skipARA)
+        {
+            // No clear() first: the read below covers the whole buffer, and
+            // AudioFormatReader::read zero-fills any samples past the end of
+            // the source itself, so pre-zeroing would only double the write
+            // traffic over the full-file allocation.
+            juce::AudioBuffer<float> sourceBuffer (sourceChannelCount, static_cast<int>(sourceSampleCount));
 
-        juce::ARAAudioSourceReader reader (audioSource);
-        reader.read (&sourceBuffer, 0, static_cast<int>(sourceSampleCount), 0, true, true);
+            juce::ARAAudioSourceReader reader (audioSource);
+            reader.read (&sourceBuffer, 0, static_cast<int>(sourceSampleCount), 0, true, true);
 
-        // Check if we got any audio (quick check on first 1000 samples to avoid scanning huge files)
-        float maxSample = 0.0f;
-        int samplesToCheck = juce::jmin (1000, static_cast<int>(sourceSampleCount));
-        for (int ch = 0; ch < sourceChannelCount && maxSample < 0.00001f; ++ch)
-        {
-            auto range = sourceBuffer.findMinMax (ch, 0, samplesToCheck);
-            maxSample = juce::jmax (maxSample, juce::jmax (std::abs (range.getStart()), std::abs (range.getEnd())));
-        }
+            // Quick check on the first 1000 samples to avoid scanning huge
+            // files. The probe picks the source to read from, it never gates
+            // the resample: a quiet lead-in is indistinguishable from a dead
+            // read at this window size, so the ARA data is only discarded
+            // once a usable fallback reader actually exists - otherwise
+            // whatever the read returned is still the best data there is.
+            if (! isSilent (sourceBuffer, juce::jmin (1000, static_cast<int>(sourceSampleCount))))
+            {
+                resampleLoaded (sourceBuffer, speedRatio, buffer);
+                gotAudio = true;
+            }
+            else
+            {
+                if (fileAvailable)
+                    fileReader = createFileReader (audioFile);
 
-        if (maxSample > 0.00001f) // Found audio
-            gotAudio = true;
+                if (fileReader == nullptr)
+                {
+                    log ("ResamplingExporter: WARNING - ARA read looks silent and no file fallback is available, resampling it anyway");
+                    resampleLoaded (sourceBuffer, speedRatio, buffer);
+                    gotAudio = true;
+                }
+            }
+        }
 
         // If ARA read failed, try reading directly from file (REAPER ARA bug workaround)
         if (!gotAudio)
         {
-            log ("ResamplingExporter: WARNING - ARA read returned silence, trying direct file access...");
-
-            // Try to get file path from ReaSpeechLiteAudioSource
-            juce::String filePath;
-            if (auto* rsAudioSource = dynamic_cast<ReaSpeechLiteAudioSource*>(audioSource))
-                filePath = rsAudioSource->getFilePath();
+            if (! skipARA)
+                log ("ResamplingExporter: WARNING - ARA read returned silence, trying direct file access...");
 
-            if (filePath.isNotEmpty())
+            if (fileAvailable)
             {
-                juce::File audioFile (filePath);
-                if (audioFile.existsAsFile())
+                log ("ResamplingExporter: Reading from file: " + filePath);
+
+                if (fileReader == nullptr)
+                    fileReader = createFileReader (audioFile);
+
+                if (fileReader != nullptr)
                 {
-                    log ("ResamplingExporter: Reading from file: " + filePath);
+                    const auto samplesToRead = juce::jmin (static_cast<juce::int64>(sourceSampleCount),
+                                                           fileReader->lengthInSamples);
 
-                    juce::AudioFormatManager formatManager;
-                    formatManager.registerBasicFormats();
+                    // Probe the head of the file as the ARA path does. The
+                    // result only shapes the log line and the broken-ARA
+                    // marker below - the file is streamed either way, since
+                    // the probe window may just cover a quiet lead-in.
+                    const auto probeSamples = static_cast<int>(juce::jmin ((juce::int64) 1000, samplesToRead));
+                    juce::AudioBuffer<float> probe (sourceChannelCount, probeSamples);
+                    fileReader->read (&probe, 0, probeSamples, 0, true, true);
 
-                    std::unique_ptr<juce::AudioFormatReader> fileReader (formatManager.createReaderFor (audioFile));
-                    if (fileReader != nullptr)
-                    {
-                        // Read directly from file
-                        int samplesToRead = juce::jmin (static_cast<int>(sourceSampleCount),
-                                                       static_cast<int>(fileReader->lengthInSamples));
-                        fileReader->read (&sourceBuffer, 0, samplesToRead, 0, true, true);
-
-                        // Check if file read succeeded (quick check on first 1000 samples)
-                        float maxSample = 0.0f;
-                        int samplesToCheck = juce::jmin (1000, samplesToRead);
-                        for (int ch = 0; ch < sourceChannelCount && maxSample < 0.00001f; ++ch)
-                        {
-                            auto range = sourceBuffer.findMinMax (ch, 0, samplesToCheck);
-                            maxSample = juce::jmax (maxSample, juce::jmax (std::abs (range.getStart()), std::abs (range.getEnd())));
-                        }
-
-                        if (maxSample > 0.00001f)
-                            gotAudio = true;
-                        else
-                            log ("ResamplingExporter: File read also returned silence");
-                    }
-                    else
+                    const bool fileHasAudio = ! isSilent (probe, probeSamples);
+
+                    if (! fileHasAudio)
+                        log ("ResamplingExporter: File probe also looks silent, resampling the file anyway");
+
+                    // Stream the file through the resampler in blockSize
+                    // chunks - this path never holds more than a
+                    // block-sized window in memory, so the full-file
+                    // buffer above is not paid twice.
+                    juce::AudioBuffer<float> block (sourceChannelCount, blockSize);
+
+                    resampleBlocks ([&fileReader, &block] (float* dest, juce::int64 start, int numSamples)
                     {
-                        log ("ResamplingExporter: Failed to create reader for file");
-                    }
+                        fileReader->read (&block, 0, numSamples, start, true, true);
+                        mixToMono (block, 0, dest, numSamples);
+                    }, samplesToRead, speedRatio, buffer);
+
+                    gotAudio = true;
+
+                    // Remember the failure mode: the host just handed us
+                    // silence over ARA for audio the file plainly has, so
+                    // later exports go straight to the file. A silent file
+                    // probe proves nothing about ARA, so it leaves the
+                    // marker alone.
+                    if (fileHasAudio && ! skipARA)
+                        araKnownBroken.store (true, std::memory_order_relaxed);
                 }
                 else
                 {
-                    log ("ResamplingExporter: File does not exist: " + filePath);
+                    log ("ResamplingExporter: Failed to create reader for file");
                 }
             }
+            else if (filePath.isNotEmpty())
+            {
+                log ("ResamplingExporter: File does not exist: " + filePath);
+            }
             else
             {
                 log ("ResamplingExporter: No file path available for direct read");
             }
         }
 
-        // Calculate destination buffer size
-        const double speedRatio = sourceSampleRate / destSampleRate; // Source samples per dest sample
-        const auto destSampleCount = juce::roundToInt (sourceSampleCount * destSampleRate / sourceSampleRate);
-        buffer.resize (static_cast<size_t>(destSampleCount));
+        // The max-amplitude pass exists only to feed the log line below, so
+        // the whole-buffer scan is skipped when nothing would print it
+        // (DBG compiles away in release builds, making log() a no-op when no
+        // logger is attached).
+#if JUCE_DEBUG
+        const bool wantDiagnostics = true;
+#else
+        const bool wantDiagnostics = logger != nullptr;
+#endif
 
-        // Mix down to mono if needed and resample
-        juce::LagrangeInterpolator interpolator;
-        interpolator.reset();
+        if (wantDiagnostics)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax (buffer.data(), static_cast<int>(buffer.size()));
+            const auto maxAmplitude = juce::jmax (std::abs (range.getStart()), std::abs (range.getEnd()));
+
+            log ("ResamplingExporter: Resampled to " + juce::String (destSampleCount) +
+                 " samples at " + juce::String (destSampleRate) + " Hz, max amplitude: " + juce::String (maxAmplitude, 6));
+        }
+    }
+
+private:
+    // Registering the basic formats constructs every format object (WAV,
+    // AIFF, FLAC, MP3, ...), so the manager is built once and shared across
+    // exports instead of per fallback. Initialization is thread-safe via the
+    // function-local static.
+    static juce::AudioFormatManager& sharedFormatManager()
+    {
+        struct RegisteredFormatManager : juce::AudioFormatManager
+        {
+            RegisteredFormatManager() { registerBasicFormats(); }
+        };
+
+        static RegisteredFormatManager formatManager;
+        return formatManager;
+    }
+
+    // Prefers a memory-mapped reader when the format supports one (WAV,
+    // AIFF): the OS page cache then serves the block-sized streaming window
+    // directly, skipping the userspace read copy. Compressed formats, and
+    // files whose mapping fails, fall back to the ordinary streaming reader.
+    static std::unique_ptr<juce::AudioFormatReader> createFileReader (const juce::File& audioFile)
+    {
+        auto& formatManager = sharedFormatManager();
+
+        if (auto* format = formatManager.findFormatForFileExtension (audioFile.getFileExtension()))
+            if (auto mapped = std::unique_ptr<juce::MemoryMappedAudioFormatReader> (format->createMemoryMappedReader (audioFile)))
+                if (mapped->mapEntireFile())
+                    return mapped;
+
+        return std::unique_ptr<juce::AudioFormatReader> (formatManager.createReaderFor (audioFile));
+    }
+
+    // Threshold below which the probe window counts as silence.
+    static constexpr float silenceThreshold = 0.00001f;
+
+    // Set once an ARA read has returned silence for a source whose file
+    // plainly has audio; exports with a resolvable file then skip the
+    // full-file ARA read entirely (see exportAudio).
+    inline static std::atomic<bool> araKnownBroken { false };
+
+    // True when every channel's probe window stays below the silence
+    // threshold. getMagnitude folds the separate min/max comparisons into
+    // one max-|x| reduction per channel, and the loop stops at the first
+    // channel carrying signal.
+    static bool isSilent (const juce::AudioBuffer<float>& buffer, const int samplesToCheck)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            if (buffer.getMagnitude (ch, 0, samplesToCheck) > silenceThreshold)
+                return false;
+
+        return true;
+    }
+
+    // Resamples an already-loaded source to mono output. Kept for the ARA
+    // path, where the host bug forces a single full read (see exportAudio).
+    static void resampleLoaded (const juce::AudioBuffer<float>& sourceBuffer,
+                                const double speedRatio,
+                                std::vector<float>& buffer)
+    {
+        const auto destSampleCount = static_cast<int>(buffer.size());
+        const auto sourceChannelCount = sourceBuffer.getNumChannels();
+        const auto numSourceSamples = sourceBuffer.getNumSamples();
 
         if (sourceChannelCount == 1)
         {
             // Mono source - direct resample
+            juce::LagrangeInterpolator interpolator;
+            interpolator.reset();
             interpolator.process (speedRatio,
                                  sourceBuffer.getReadPointer(0),
                                  buffer.data(),
@@ -154,29 +283,94 @@ struct ResamplingExporter
         }
         else
         {
-            // Multi-channel - mix to mono first, then resample
-            std::vector<float> monoSource (sourceSampleCount);
+            // Multi-channel - mix to mono block by block inside the resample
+            // loop, straight from the source's channel pointers. The mix for
+            // a block happens right before the interpolator consumes it, so
+            // no full-length mono copy of the source is ever materialized.
+            resampleBlocks ([&sourceBuffer] (float* dest, juce::int64 start, int numSamples)
+            {
+                mixToMono (sourceBuffer, static_cast<int>(start), dest, numSamples);
+            }, numSourceSamples, speedRatio, buffer);
+        }
+    }
+
+    // Mixes a run of samples starting at sourceStart down to a mono
+    // destination using the vectorized copy/add/scale sequence.
+    static void mixToMono (const juce::AudioBuffer<float>& source, const int sourceStart, float* dest, const int numSamples)
+    {
+        const auto numChannels = source.getNumChannels();
+
+        juce::FloatVectorOperations::copy (dest, source.getReadPointer (0) + sourceStart, numSamples);
 
-            for (int i = 0; i < static_cast<int>(sourceSampleCount); ++i)
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::add (dest, source.getReadPointer (ch) + sourceStart, numSamples);
+
+        if (numChannels > 1)
+            juce::FloatVectorOperations::multiply (dest, 1.0f / static_cast<float> (numChannels), numSamples);
+    }
+
+    // Pulls the source through the stateful interpolator one block at a
+    // time: mixBlock (dest, start, numSamples) must write the mono mix of
+    // that source range into dest. Only a block-sized window is alive at
+    // once, so memory stays flat regardless of source length.
+    template <typename MixBlock>
+    static void resampleBlocks (MixBlock&& mixBlock,
+                                const juce::int64 sourceSampleCount,
+                                const double speedRatio,
+                                std::vector<float>& buffer)
+    {
+        // Headroom for the interpolator's tap lookahead plus the rounding
+        // slack of the final output count (up to half a ratio's worth of
+        // source samples).
+        constexpr int margin = 32;
+
+        std::vector<float> mono (static_cast<size_t>(blockSize + margin));
+
+        juce::LagrangeInterpolator interpolator;
+        interpolator.reset();
+
+        const auto destSampleCount = static_cast<int>(buffer.size());
+        juce::int64 readPos = 0;
+        int produced = 0;
+
+        while (produced < destSampleCount)
+        {
+            const auto remaining = juce::jmax ((juce::int64) 0, sourceSampleCount - readPos);
+            const auto numSamples = static_cast<int>(juce::jmin ((juce::int64) blockSize, remaining));
+
+            if (numSamples > 0)
+                mixBlock (mono.data(), readPos, numSamples);
+
+            const bool lastBlock = remaining <= (juce::int64) blockSize;
+            int numOut = 0;
+
+            if (lastBlock)
+            {
+                // Zero-pad so the tap window stays in bounds while the final
+                // outputs drain.
+                std::fill (mono.begin() + numSamples, mono.end(), 0.0f);
+                numOut = destSampleCount - produced;
+            }
+            else
             {
-                float sample = 0.0f;
-                for (int ch = 0; ch < sourceChannelCount; ++ch)
-                    sample += sourceBuffer.getSample(ch, i);
-                monoSource[static_cast<size_t>(i)] = sample / static_cast<float>(sourceChannelCount);
+                // Only ask for outputs whose input needs fit in this block;
+                // the margin keeps the tap window off the block's edge.
+                numOut = juce::jmin (destSampleCount - produced,
+                                     static_cast<int>((numSamples - margin) / speedRatio));
             }
 
-            interpolator.process (speedRatio,
-                                 monoSource.data(),
-                                 buffer.data(),
-                                 destSampleCount);
-        }
+            if (numOut <= 0)
+                break;
 
-        // Calculate max amplitude for diagnostics
-        float maxAmplitude = 0.0f;
-        for (const auto& sample : buffer)
-            maxAmplitude = juce::jmax (maxAmplitude, std::abs (sample));
+            // process() reports how much input those outputs consumed; the
+            // unconsumed tail is simply re-presented at the next block's
+            // start instead of being shuffled within the scratch buffer.
+            const auto consumed = interpolator.process (speedRatio, mono.data(), buffer.data() + produced, numOut);
+            produced += numOut;
+            readPos += consumed;
 
-        log ("ResamplingExporter: Resampled to " + juce::String (destSampleCount) +
-             " samples at " + juce::String (destSampleRate) + " Hz, max amplitude: " + juce::String (maxAmplitude, 6));
+            if (lastBlock)
+                break;
+        }
     }
 };
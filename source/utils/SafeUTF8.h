@@ -1,16 +1,33 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <string>
+
 #include <juce_core/juce_core.h>
 
 struct SafeUTF8
 {
     static juce::String encode (const char* const buffer)
+    {
+        return juce::String::fromUTF8 (sanitize (buffer).c_str());
+    }
+
+    // Validates UTF-8 in place, replacing broken sequences, without leaving
+    // the std::string domain - for callers that keep text as raw UTF-8.
+    static std::string sanitize (const char* const buffer)
     {
         if (buffer == nullptr)
             return {};
 
         std::string input(buffer);
+
+        // Fast path: pure-ASCII input (the common case for track and file
+        // names) is valid UTF-8 by construction and can be returned as-is,
+        // skipping the per-sequence validation below.
+        if (isAscii (input.data(), input.length()))
+            return input;
+
         std::string output;
         output.reserve(input.length());
 
@@ -65,6 +82,29 @@ struct SafeUTF8
             i += valid ? len : 1;
         }
 
-        return juce::String::fromUTF8(output.c_str());
+        return output;
+    }
+
+private:
+    // Checks eight bytes per iteration against the high-bit mask; memcpy
+    // keeps the word loads well-defined regardless of alignment.
+    static bool isAscii (const char* data, size_t length) noexcept
+    {
+        constexpr std::uint64_t highBits = 0x8080808080808080ULL;
+        size_t i = 0;
+
+        for (; i + sizeof (std::uint64_t) <= length; i += sizeof (std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy (&word, data + i, sizeof (word));
+            if ((word & highBits) != 0)
+                return false;
+        }
+
+        for (; i < length; ++i)
+            if ((static_cast<unsigned char> (data[i]) & 0x80u) != 0)
+                return false;
+
+        return true;
     }
 };